@@ -46,7 +46,9 @@ kotlin {
             dependencies {
                 implementation(libs.kotlinx.coroutines.core)
                 implementation(libs.kotlinx.serialization.json)
+                implementation(libs.kotlinx.serialization.json.io)
                 implementation(libs.kotlinx.datetime)
+                implementation(libs.kotlinx.io.core)
                 implementation(libs.ktor.client.core)
                 implementation(libs.ktor.client.content.negotiation)
                 implementation(libs.ktor.serialization.kotlinx.json)
@@ -82,8 +84,29 @@ kotlin {
                 implementation(libs.kotlin.test)
                 implementation(libs.kotlinx.coroutines.test)
                 implementation(libs.koin.test)
+                implementation(libs.ktor.client.mock)
             }
         }
+
+        val androidUnitTest by getting {
+            dependencies {
+                implementation(libs.okhttp.mockwebserver)
+            }
+        }
+
+        val iosTest by creating {
+            dependsOn(commonTest)
+        }
+
+        val iosX64Test by getting {
+            dependsOn(iosTest)
+        }
+        val iosArm64Test by getting {
+            dependsOn(iosTest)
+        }
+        val iosSimulatorArm64Test by getting {
+            dependsOn(iosTest)
+        }
     }
 }
 
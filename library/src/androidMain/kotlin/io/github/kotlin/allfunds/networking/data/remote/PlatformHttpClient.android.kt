@@ -0,0 +1,73 @@
+package io.github.kotlin.allfunds.networking.data.remote
+
+import io.ktor.client.HttpClient
+import io.ktor.client.HttpClientConfig
+import io.ktor.client.engine.okhttp.OkHttp
+import okhttp3.Call
+import okhttp3.Connection
+import okhttp3.ConnectionPool
+import okhttp3.Dispatcher
+import okhttp3.EventListener
+import okhttp3.Protocol
+import java.net.InetSocketAddress
+import java.net.Proxy
+import java.util.concurrent.TimeUnit
+import java.util.concurrent.atomic.AtomicInteger
+
+internal actual fun platformHttpClient(pool: ConnectionPoolConfig, block: HttpClientConfig<*>.() -> Unit): PlatformHttpClient {
+    val connectionPool = ConnectionPool(pool.maxIdleConnections, pool.keepAlive.inWholeMilliseconds, TimeUnit.MILLISECONDS)
+    val counter = ConnectionCounter()
+    val client = HttpClient(OkHttp) {
+        engine {
+            config {
+                connectionPool(connectionPool)
+                pool.protocol?.let { protocols(it.okHttpProtocols()) }
+                eventListener(counter)
+                dispatcher(
+                    Dispatcher().apply {
+                        maxRequests = pool.maxRequests
+                        // Over HTTP/2 the per-host limit caps the streams on the shared connection
+                        maxRequestsPerHost = when (pool.protocol) {
+                            HttpProtocol.HTTP_2, HttpProtocol.HTTP_2_PRIOR_KNOWLEDGE -> pool.maxConcurrentStreams
+                            HttpProtocol.HTTP_1_1, null -> pool.maxConnectionsPerHost
+                        }
+                    }
+                )
+            }
+        }
+        block()
+    }
+    return PlatformHttpClient(client) {
+        ConnectionStats(
+            openConnections = connectionPool.connectionCount(),
+            idleConnections = connectionPool.idleConnectionCount(),
+            connectionsEstablished = counter.established.get(),
+            http2Exchanges = counter.http2.get(),
+            http1Exchanges = counter.http1.get()
+        )
+    }
+}
+
+private fun HttpProtocol.okHttpProtocols(): List<Protocol> = when (this) {
+    HttpProtocol.HTTP_1_1 -> listOf(Protocol.HTTP_1_1)
+    HttpProtocol.HTTP_2 -> listOf(Protocol.HTTP_2, Protocol.HTTP_1_1)
+    HttpProtocol.HTTP_2_PRIOR_KNOWLEDGE -> listOf(Protocol.H2_PRIOR_KNOWLEDGE)
+}
+
+/**
+ * Counts the connections an OkHttp client opens and the protocol of every exchange
+ */
+private class ConnectionCounter : EventListener() {
+    val established = AtomicInteger()
+    val http2 = AtomicInteger()
+    val http1 = AtomicInteger()
+
+    override fun connectEnd(call: Call, inetSocketAddress: InetSocketAddress, proxy: Proxy, protocol: Protocol?) {
+        established.incrementAndGet()
+    }
+
+    override fun connectionAcquired(call: Call, connection: Connection) {
+        val protocol = connection.protocol()
+        if (protocol == Protocol.HTTP_2 || protocol == Protocol.H2_PRIOR_KNOWLEDGE) http2.incrementAndGet() else http1.incrementAndGet()
+    }
+}
@@ -0,0 +1,136 @@
+package io.github.kotlin.allfunds.networking.data.remote.decode
+
+import java.util.zip.CRC32
+import java.util.zip.Inflater
+
+// Setting Accept-Encoding turns off OkHttp's transparent gzip, so the library decodes both itself
+internal actual val decodableContentEncodings: List<String> = listOf("gzip", "deflate")
+
+internal actual fun decompressor(contentEncoding: String): Decompressor? = when (contentEncoding.trim().lowercase()) {
+    "gzip", "x-gzip" -> ZipDecompressor(gzip = true)
+    "deflate" -> ZipDecompressor(gzip = false)
+    else -> null
+}
+
+/**
+ * [Inflater] behind the gzip or deflate framing
+ *
+ * The first bytes are held back until the framing is known: the gzip header is skipped, and a
+ * deflate body is checked for the zlib header that most, but not all, servers send. A gzip body
+ * is only finished once its trailer has arrived and matches the CRC-32 and size of the output,
+ * so a truncated or corrupted body fails instead of decoding as whatever came through.
+ */
+private class ZipDecompressor(private val gzip: Boolean) : Decompressor {
+    private var inflater: Inflater? = null
+    private var head = ByteArray(0)
+
+    // Input handed to the inflater last, to find the bytes it left after the deflate stream
+    private var input = head
+    private var inputEnd = 0
+
+    private val crc = CRC32()
+    private var size = 0
+    private val trailer = ByteArray(GZIP_TRAILER)
+    private var trailerLength = 0
+
+    override val finished: Boolean
+        get() = inflater?.finished() == true && (!gzip || trailerLength == GZIP_TRAILER)
+
+    override fun needsInput(): Boolean {
+        val current = inflater ?: return true
+        return if (current.finished()) !finished else current.needsInput()
+    }
+
+    override fun setInput(bytes: ByteArray, offset: Int, length: Int) {
+        val current = inflater
+        if (current != null) {
+            if (current.finished()) {
+                readTrailer(bytes, offset, length)
+                return
+            }
+            current.setInput(bytes, offset, length)
+            input = bytes
+            inputEnd = offset + length
+            return
+        }
+        head += bytes.copyOfRange(offset, offset + length)
+        val start = if (gzip) gzipHeaderLength(head) else if (head.size >= 2) 0 else -1
+        if (start < 0) return
+        inflater = Inflater(gzip || !isZlib(head)).also { it.setInput(head, start, head.size - start) }
+        input = head
+        inputEnd = head.size
+    }
+
+    override fun inflate(output: ByteArray, offset: Int, length: Int): Int {
+        val current = inflater ?: return 0
+        if (current.finished()) return 0
+        val written = current.inflate(output, offset, length)
+        check(written > 0 || current.needsInput() || current.finished()) { "Unsupported deflate stream" }
+        if (gzip) {
+            crc.update(output, offset, written)
+            size += written
+            if (current.finished()) readTrailer(input, inputEnd - current.remaining, current.remaining)
+        }
+        return written
+    }
+
+    /**
+     * Collect the gzip trailer from the bytes after the deflate stream, checking it once complete
+     */
+    private fun readTrailer(bytes: ByteArray, offset: Int, length: Int) {
+        val taken = minOf(length, GZIP_TRAILER - trailerLength)
+        bytes.copyInto(trailer, trailerLength, offset, offset + taken)
+        trailerLength += taken
+        if (trailerLength < GZIP_TRAILER) return
+        check(littleEndianInt(trailer, 0) == crc.value.toInt()) { "gzip body failed its CRC check" }
+        // ISIZE is the output size modulo 2^32, which Int overflow matches
+        check(littleEndianInt(trailer, 4) == size) { "gzip body size does not match its trailer" }
+    }
+
+    private fun littleEndianInt(bytes: ByteArray, offset: Int): Int =
+        (bytes[offset].toInt() and 0xFF) or
+            ((bytes[offset + 1].toInt() and 0xFF) shl 8) or
+            ((bytes[offset + 2].toInt() and 0xFF) shl 16) or
+            ((bytes[offset + 3].toInt() and 0xFF) shl 24)
+
+    override fun end() {
+        inflater?.end()
+    }
+
+    private fun isZlib(bytes: ByteArray): Boolean {
+        val cmf = bytes[0].toInt() and 0xFF
+        val flg = bytes[1].toInt() and 0xFF
+        return cmf and 0x0F == 8 && (cmf * 256 + flg) % 31 == 0
+    }
+
+    /**
+     * Length of the gzip header at the start of [bytes], or -1 if it has not fully arrived
+     */
+    private fun gzipHeaderLength(bytes: ByteArray): Int {
+        if (bytes.size < GZIP_FIXED_HEADER) return -1
+        check(bytes[0] == 0x1F.toByte() && bytes[1] == 0x8B.toByte() && bytes[2] == 8.toByte()) { "Not a gzip body" }
+        val flags = bytes[3].toInt()
+        var position = GZIP_FIXED_HEADER
+        if (flags and FLAG_EXTRA != 0) {
+            if (bytes.size < position + 2) return -1
+            position += 2 + ((bytes[position].toInt() and 0xFF) or ((bytes[position + 1].toInt() and 0xFF) shl 8))
+        }
+        for (flag in intArrayOf(FLAG_NAME, FLAG_COMMENT)) {
+            if (flags and flag == 0) continue
+            while (position < bytes.size && bytes[position] != 0.toByte()) position++
+            if (position >= bytes.size) return -1
+            position++
+        }
+        if (flags and FLAG_HEADER_CRC != 0) position += 2
+        return if (position <= bytes.size) position else -1
+    }
+
+    private companion object {
+        const val GZIP_FIXED_HEADER = 10
+        const val GZIP_TRAILER = 8
+        const val FLAG_HEADER_CRC = 2
+        const val FLAG_EXTRA = 4
+        const val FLAG_NAME = 8
+        const val FLAG_COMMENT = 16
+    }
+}
@@ -0,0 +1,107 @@
+package io.github.kotlin.allfunds.networking
+
+import io.github.kotlin.allfunds.networking.data.remote.ChuckNorrisApiConfig
+import kotlinx.coroutines.runBlocking
+import java.net.ServerSocket
+import java.net.Socket
+import java.util.concurrent.CopyOnWriteArrayList
+import kotlin.concurrent.thread
+import kotlin.test.AfterTest
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertTrue
+
+/**
+ * Closing clients on the real OkHttp engine releases its sockets and threads
+ */
+class ClientLeakTest {
+
+    private val server = KeepAliveServer()
+
+    @AfterTest
+    fun tearDown() {
+        server.close()
+    }
+
+    @Test
+    fun closeReleasesSocketsAndEngineThreads() = runBlocking {
+        val threadsBefore = engineThreads()
+
+        repeat(CLIENTS) {
+            val client = ChuckNorrisClient(ChuckNorrisApiConfig(baseUrl = "http://127.0.0.1:${server.port}/jokes"))
+            client.use { assertEquals(listOf("dev"), it.getCategories()) }
+        }
+
+        assertTrue(awaitTrue { server.openSockets() == 0 }, "open sockets: ${server.openSockets()}")
+        assertTrue(awaitTrue { (engineThreads() - threadsBefore).isEmpty() }, "leaked: ${engineThreads() - threadsBefore}")
+    }
+
+    /**
+     * Threads owned by OkHttp clients; the TaskRunner threads are shared by all clients and idle out on their own
+     */
+    private fun engineThreads(): Set<String> = Thread.getAllStackTraces().keys
+        .filter { it.isAlive && it.name.startsWith("OkHttp") && !it.name.contains("TaskRunner") }
+        .map { "${it.name}#${it.id}" }
+        .toSet()
+
+    private fun awaitTrue(condition: () -> Boolean): Boolean {
+        val deadline = System.nanoTime() + 10_000_000_000L
+        while (System.nanoTime() < deadline) {
+            if (condition()) return true
+            Thread.sleep(20)
+        }
+        return condition()
+    }
+
+    /**
+     * Minimal HTTP/1.1 server answering every request with the categories payload and keeping
+     * connections alive, so sockets stay open until the client closes them
+     */
+    private class KeepAliveServer : AutoCloseable {
+        private val socket = ServerSocket(0)
+        private val connections = CopyOnWriteArrayList<Socket>()
+        val port: Int = socket.localPort
+
+        init {
+            thread(isDaemon = true, name = "keep-alive-server") {
+                while (!socket.isClosed) {
+                    val connection = runCatching { socket.accept() }.getOrNull() ?: break
+                    connections += connection
+                    thread(isDaemon = true) { serve(connection) }
+                }
+            }
+        }
+
+        fun openSockets(): Int = connections.count { !it.isClosed }
+
+        private fun serve(connection: Socket) {
+            connection.use {
+                val input = it.getInputStream().bufferedReader()
+                val output = it.getOutputStream()
+                while (true) {
+                    // Request line and headers, up to the blank line; null once the client hangs up
+                    var line = input.readLine() ?: return
+                    while (line.isNotEmpty()) line = input.readLine() ?: return
+                    output.write(
+                        ("HTTP/1.1 200 OK\r\nContent-Type: application/json\r\n" +
+                            "Content-Length: ${BODY.length}\r\n\r\n$BODY").toByteArray()
+                    )
+                    output.flush()
+                }
+            }
+        }
+
+        override fun close() {
+            socket.close()
+            connections.forEach { it.close() }
+        }
+
+        private companion object {
+            const val BODY = "[\"dev\"]"
+        }
+    }
+
+    private companion object {
+        const val CLIENTS = 5
+    }
+}
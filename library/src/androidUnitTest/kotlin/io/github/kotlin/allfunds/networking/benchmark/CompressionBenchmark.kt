@@ -0,0 +1,103 @@
+package io.github.kotlin.allfunds.networking.benchmark
+
+import io.github.kotlin.allfunds.networking.data.remote.CallTiming
+import io.github.kotlin.allfunds.networking.data.remote.ChuckNorrisApiConfig
+import io.github.kotlin.allfunds.networking.data.remote.ChuckNorrisApiImpl
+import io.github.kotlin.allfunds.networking.loadtest.JokeFixtures
+import kotlinx.coroutines.runBlocking
+import okhttp3.mockwebserver.Dispatcher
+import okhttp3.mockwebserver.MockResponse
+import okhttp3.mockwebserver.MockWebServer
+import okhttp3.mockwebserver.RecordedRequest
+import okio.Buffer
+import java.io.ByteArrayOutputStream
+import java.util.concurrent.TimeUnit
+import java.util.zip.GZIPOutputStream
+import kotlin.random.Random
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertTrue
+import kotlin.time.Duration
+import kotlin.time.TimeSource
+
+/**
+ * Bandwidth and latency of compressed against uncompressed search responses over a throttled link,
+ * on the real OkHttp engine
+ */
+class CompressionBenchmark {
+
+    @Test
+    fun compressionTradesDecompressionTimeForBandwidth() = runBlocking {
+        for (count in listOf(10, 100, 1000)) {
+            val payload = JokeFixtures.encode(JokeFixtures.searchResponse(Random(count), count)).encodeToByteArray()
+            val plain = measure(payload, compression = false)
+            val compressed = measure(payload, compression = true)
+
+            assertEquals(payload.size, plain.timing.wireBytes)
+            assertEquals(payload.size, compressed.timing.responseBytes)
+            assertTrue(compressed.timing.wireBytes < payload.size, "wire bytes ${compressed.timing.wireBytes}")
+            assertEquals(plain.jokeIds, compressed.jokeIds)
+
+            BenchmarkLog.append(
+                "compression-$count",
+                mapOf(
+                    "bodyBytes" to payload.size,
+                    "compressedBytes" to compressed.timing.wireBytes,
+                    "plainMillis" to plain.latency.inWholeMilliseconds,
+                    "compressedMillis" to compressed.latency.inWholeMilliseconds,
+                    "decompressionMicros" to compressed.timing.decompression.inWholeMicroseconds
+                )
+            )
+        }
+    }
+
+    private class Measurement(val timing: CallTiming, val latency: Duration, val jokeIds: List<String>)
+
+    private suspend fun measure(payload: ByteArray, compression: Boolean): Measurement {
+        val server = MockWebServer().apply {
+            dispatcher = SearchDispatcher(payload, compress = compression)
+            start()
+        }
+        var timing: CallTiming? = null
+        val api = ChuckNorrisApiImpl(
+            ChuckNorrisApiConfig(
+                baseUrl = server.url("/jokes").toString(),
+                responseCompression = compression,
+                listener = { timing = it }
+            )
+        )
+        try {
+            // The first call pays for the connection and class loading
+            api.searchJokeList("warm-up")
+            val start = TimeSource.Monotonic.markNow()
+            val jokes = api.searchJokeList("kick")
+            return Measurement(timing!!, start.elapsedNow(), jokes.map { it.id })
+        } finally {
+            api.close()
+            server.shutdown()
+        }
+    }
+
+    /**
+     * Serves the search payload over a link of about 1 MB/s, gzip-compressed when [compress] is set
+     * and the client accepts it
+     */
+    private class SearchDispatcher(payload: ByteArray, private val compress: Boolean) : Dispatcher() {
+        private val plain = payload
+        private val gzipped = ByteArrayOutputStream().also { out -> GZIPOutputStream(out).use { it.write(payload) } }.toByteArray()
+
+        override fun dispatch(request: RecordedRequest): MockResponse {
+            val gzip = compress && request.getHeader("Accept-Encoding")?.contains("gzip") == true
+            return MockResponse()
+                .setHeader("Content-Type", "application/json")
+                .apply { if (gzip) setHeader("Content-Encoding", "gzip") }
+                .setBody(Buffer().write(if (gzip) gzipped else plain))
+                .throttleBody(BYTES_PER_PERIOD, PERIOD_MILLIS, TimeUnit.MILLISECONDS)
+        }
+    }
+
+    private companion object {
+        const val BYTES_PER_PERIOD = 16L * 1024
+        const val PERIOD_MILLIS = 16L
+    }
+}
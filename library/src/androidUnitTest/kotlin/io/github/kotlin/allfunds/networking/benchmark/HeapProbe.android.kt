@@ -0,0 +1,20 @@
+package io.github.kotlin.allfunds.networking.benchmark
+
+actual val platformName: String = "jvm-${System.getProperty("java.version")}"
+
+actual fun retainedHeapBytes(): Long {
+    val runtime = Runtime.getRuntime()
+    // A single System.gc() is only a hint; repeat until the used heap stops shrinking
+    var used = Long.MAX_VALUE
+    repeat(MAX_GC_ROUNDS) {
+        System.gc()
+        Thread.sleep(GC_SETTLE_MILLIS)
+        val now = runtime.totalMemory() - runtime.freeMemory()
+        if (now >= used) return now
+        used = now
+    }
+    return used
+}
+
+private const val MAX_GC_ROUNDS = 5
+private const val GC_SETTLE_MILLIS = 50L
@@ -0,0 +1,102 @@
+package io.github.kotlin.allfunds.networking.benchmark
+
+import io.github.kotlin.allfunds.networking.data.remote.ChuckNorrisApiConfig
+import io.github.kotlin.allfunds.networking.data.remote.ChuckNorrisApiImpl
+import io.github.kotlin.allfunds.networking.data.remote.ConnectionPoolConfig
+import io.github.kotlin.allfunds.networking.data.remote.ConnectionStats
+import io.github.kotlin.allfunds.networking.data.remote.HttpProtocol
+import kotlinx.coroutines.async
+import kotlinx.coroutines.awaitAll
+import kotlinx.coroutines.runBlocking
+import okhttp3.Protocol
+import okhttp3.mockwebserver.Dispatcher
+import okhttp3.mockwebserver.MockResponse
+import okhttp3.mockwebserver.MockWebServer
+import okhttp3.mockwebserver.RecordedRequest
+import java.util.concurrent.TimeUnit
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertTrue
+import kotlin.time.Duration
+import kotlin.time.TimeSource
+
+/**
+ * Fan-out over HTTP/1.1 connections against multiplexed HTTP/2 streams on the real OkHttp engine
+ */
+class Http2Benchmark {
+
+    private class Result(val stats: ConnectionStats, val latencies: List<Duration>, val wall: Duration) {
+        fun percentile(p: Double): Duration = latencies.sorted()[((latencies.size - 1) * p).toInt()]
+    }
+
+    @Test
+    fun http2MultiplexesFanOutOnOneConnection() {
+        val http1 = fanOut(HttpProtocol.HTTP_1_1, Protocol.HTTP_1_1)
+        val http2 = fanOut(HttpProtocol.HTTP_2_PRIOR_KNOWLEDGE, Protocol.H2_PRIOR_KNOWLEDGE)
+
+        for ((name, result) in listOf("http1" to http1, "http2" to http2)) {
+            BenchmarkLog.append(
+                "fan-out-$name",
+                mapOf(
+                    "connectionsEstablished" to result.stats.connectionsEstablished,
+                    "p50Millis" to result.percentile(0.5).inWholeMilliseconds,
+                    "p99Millis" to result.percentile(0.99).inWholeMilliseconds,
+                    "wallMillis" to result.wall.inWholeMilliseconds
+                )
+            )
+        }
+
+        assertEquals(1, http2.stats.connectionsEstablished)
+        assertEquals(CALLS * ROUNDS, http2.stats.http2Exchanges)
+        assertTrue(http1.stats.connectionsEstablished > 1, "HTTP/1.1 connections: ${http1.stats.connectionsEstablished}")
+        assertEquals(CALLS * ROUNDS, http1.stats.http1Exchanges)
+    }
+
+    private fun fanOut(protocol: HttpProtocol, serverProtocol: Protocol): Result = runBlocking {
+        val server = MockWebServer().apply {
+            protocols = listOf(serverProtocol)
+            dispatcher = CategoriesDispatcher
+            start()
+        }
+        val pool = ConnectionPoolConfig(
+            maxIdleConnections = STREAMS,
+            maxConnectionsPerHost = STREAMS,
+            protocol = protocol,
+            maxConcurrentStreams = STREAMS
+        )
+        val api = ChuckNorrisApiImpl(ChuckNorrisApiConfig(baseUrl = server.url("/jokes").toString(), connectionPool = pool))
+        try {
+            val start = TimeSource.Monotonic.markNow()
+            val latencies = (1..ROUNDS).flatMap {
+                List(CALLS) {
+                    async {
+                        val mark = TimeSource.Monotonic.markNow()
+                        api.getCategories()
+                        mark.elapsedNow()
+                    }
+                }.awaitAll()
+            }
+            Result(api.connectionStats()!!, latencies, start.elapsedNow())
+        } finally {
+            api.close()
+            server.shutdown()
+        }
+    }
+
+    /**
+     * Answers every request with the categories payload after a fixed server delay
+     */
+    private object CategoriesDispatcher : Dispatcher() {
+        override fun dispatch(request: RecordedRequest): MockResponse = MockResponse()
+            .setHeader("Content-Type", "application/json")
+            .setBody("""["dev","science"]""")
+            .setBodyDelay(SERVER_DELAY_MILLIS, TimeUnit.MILLISECONDS)
+    }
+
+    private companion object {
+        const val CALLS = 64
+        const val ROUNDS = 5
+        const val STREAMS = 16
+        const val SERVER_DELAY_MILLIS = 20L
+    }
+}
@@ -0,0 +1,79 @@
+package io.github.kotlin.allfunds.networking.data.remote.decode
+
+import java.io.ByteArrayOutputStream
+import java.util.zip.Deflater
+import java.util.zip.DeflaterOutputStream
+import java.util.zip.GZIPOutputStream
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertFailsWith
+import kotlin.test.assertFalse
+import kotlin.test.assertNull
+
+class DecompressorTest {
+
+    private val body = """{"total":1,"result":[{"id":"abc","value":"${"Chuck Norris ".repeat(200)}"}]}""".encodeToByteArray()
+
+    /**
+     * Feed [compressed] in chunks of [chunkSize] bytes and collect the output
+     */
+    private fun inflate(encoding: String, compressed: ByteArray, chunkSize: Int): ByteArray {
+        val decompressor = decompressor(encoding)!!
+        val output = ByteArrayOutputStream()
+        val buffer = ByteArray(64)
+        var offset = 0
+        while (!decompressor.finished) {
+            if (decompressor.needsInput()) {
+                val length = minOf(chunkSize, compressed.size - offset)
+                decompressor.setInput(compressed, offset, length)
+                offset += length
+                continue
+            }
+            val written = decompressor.inflate(buffer, 0, buffer.size)
+            output.write(buffer, 0, written)
+        }
+        decompressor.end()
+        return output.toByteArray()
+    }
+
+    @Test
+    fun gzipBodiesAreInflatedAcrossChunks() {
+        val compressed = ByteArrayOutputStream().also { out -> GZIPOutputStream(out).use { it.write(body) } }.toByteArray()
+
+        for (chunkSize in listOf(1, 7, 4096)) {
+            assertEquals(body.decodeToString(), inflate("gzip", compressed, chunkSize).decodeToString())
+        }
+    }
+
+    @Test
+    fun gzipTrailerIsChecked() {
+        val compressed = ByteArrayOutputStream().also { out -> GZIPOutputStream(out).use { it.write(body) } }.toByteArray()
+        val corrupted = compressed.copyOf().also { it[it.size - 8] = (it[it.size - 8] + 1).toByte() }
+
+        assertFailsWith<IllegalStateException> { inflate("gzip", corrupted, chunkSize = 7) }
+
+        // Without the size at the end of the trailer, the body is never finished
+        val truncated = decompressor("gzip")!!
+        truncated.setInput(compressed, 0, compressed.size - 4)
+        val buffer = ByteArray(body.size)
+        while (!truncated.needsInput()) truncated.inflate(buffer, 0, buffer.size)
+        assertFalse(truncated.finished)
+        truncated.end()
+    }
+
+    @Test
+    fun deflateBodiesAreInflatedWithOrWithoutZlibHeader() {
+        for (nowrap in listOf(false, true)) {
+            val out = ByteArrayOutputStream()
+            DeflaterOutputStream(out, Deflater(Deflater.DEFAULT_COMPRESSION, nowrap)).use { it.write(body) }
+
+            assertEquals(body.decodeToString(), inflate("deflate", out.toByteArray(), chunkSize = 3).decodeToString())
+        }
+    }
+
+    @Test
+    fun otherEncodingsAreLeftToTheEngine() {
+        assertNull(decompressor("br"))
+        assertNull(decompressor("identity"))
+    }
+}
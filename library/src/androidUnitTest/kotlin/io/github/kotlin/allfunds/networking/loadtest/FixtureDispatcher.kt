@@ -0,0 +1,31 @@
+package io.github.kotlin.allfunds.networking.loadtest
+
+import okhttp3.mockwebserver.Dispatcher
+import okhttp3.mockwebserver.MockResponse
+import okhttp3.mockwebserver.RecordedRequest
+import java.util.concurrent.TimeUnit
+import kotlin.random.Random
+
+/**
+ * Answers every endpoint of the API with a fixture payload after a fixed server delay, so a
+ * [okhttp3.mockwebserver.MockWebServer] can stand in for [ChuckNorrisStubServer] on the real engine
+ *
+ * @param delayMillis Delay before each body is sent
+ */
+class FixtureDispatcher(private val delayMillis: Long) : Dispatcher() {
+    private val randomBody = JokeFixtures.encode(JokeFixtures.joke(Random(1)))
+    private val searchBody = JokeFixtures.encode(JokeFixtures.searchResponse(Random(2), 20))
+    private val categoriesBody = JokeFixtures.encodeCategories()
+
+    override fun dispatch(request: RecordedRequest): MockResponse {
+        val body = when (request.requestUrl?.encodedPath) {
+            ChuckNorrisStubServer.CATEGORIES_PATH -> categoriesBody
+            ChuckNorrisStubServer.SEARCH_PATH -> searchBody
+            else -> randomBody
+        }
+        return MockResponse()
+            .setHeader("Content-Type", "application/json")
+            .setBody(body)
+            .setBodyDelay(delayMillis, TimeUnit.MILLISECONDS)
+    }
+}
@@ -0,0 +1,57 @@
+package io.github.kotlin.allfunds.networking.loadtest
+
+import io.github.kotlin.allfunds.networking.ChuckNorrisClient
+import io.github.kotlin.allfunds.networking.benchmark.BenchmarkLog
+import io.github.kotlin.allfunds.networking.data.remote.ChuckNorrisApiConfig
+import io.github.kotlin.allfunds.networking.data.remote.ConnectionPoolConfig
+import io.github.kotlin.allfunds.networking.trace.CallTrace
+import io.github.kotlin.allfunds.networking.trace.ClientOperation
+import io.github.kotlin.allfunds.networking.trace.TraceEvent
+import kotlinx.coroutines.runBlocking
+import okhttp3.mockwebserver.MockWebServer
+import kotlin.test.AfterTest
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertNotNull
+import kotlin.test.assertTrue
+
+/**
+ * Replaying a trace on the real OkHttp engine, where the report carries the pool's counters
+ */
+class OkHttpTraceReplayTest {
+
+    private val server = MockWebServer().apply {
+        dispatcher = FixtureDispatcher(delayMillis = 5)
+        start()
+    }
+
+    @AfterTest
+    fun tearDown() {
+        server.shutdown()
+    }
+
+    @Test
+    fun replayReportsConnectionsOfThePool() = runBlocking {
+        val pool = ConnectionPoolConfig(maxIdleConnections = POOL_SIZE, maxConnectionsPerHost = POOL_SIZE)
+        val launchBurst = List(20) { TraceEvent(offsetMicros = it * 1_000L, operation = ClientOperation.RANDOM) }
+        val batch = TraceEvent(offsetMicros = 100_000L, operation = ClientOperation.SEARCH_BATCH, argument = "kick\nchuck")
+        val trace = CallTrace(listOf(TraceEvent(0, ClientOperation.CATEGORIES)) + launchBurst + batch)
+
+        val report = ChuckNorrisClient(ChuckNorrisApiConfig(baseUrl = server.url("/jokes").toString(), connectionPool = pool)).use {
+            TraceReplayer(it, upstreamRequests = { server.requestCount }, speedup = 10.0).replay(trace)
+        }
+
+        BenchmarkLog.append("trace-replay-launch-okhttp", report.metrics())
+        assertEquals(22, report.load.completed)
+        assertEquals(0, report.load.errors)
+        assertEquals(23, report.upstreamRequests)
+        val connections = assertNotNull(report.connections)
+        assertEquals(23, connections.http1Exchanges)
+        val established = assertNotNull(report.connectionsEstablished)
+        assertTrue(established in 1..POOL_SIZE, "connections: $established")
+    }
+
+    private companion object {
+        const val POOL_SIZE = 4
+    }
+}
@@ -0,0 +1,78 @@
+package io.github.kotlin.allfunds.networking.loadtest
+
+import io.github.kotlin.allfunds.networking.ChuckNorrisClientFactory
+import io.github.kotlin.allfunds.networking.benchmark.BenchmarkLog
+import io.github.kotlin.allfunds.networking.data.remote.ChuckNorrisApiConfig
+import io.github.kotlin.allfunds.networking.data.remote.ChuckNorrisApiImpl
+import io.github.kotlin.allfunds.networking.data.remote.ConnectionPoolConfig
+import kotlinx.coroutines.runBlocking
+import okhttp3.mockwebserver.MockWebServer
+import kotlin.test.AfterTest
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertTrue
+import kotlin.time.Duration.Companion.milliseconds
+
+/**
+ * Closed-loop load over the connection pool sizes of the real OkHttp engine, against the
+ * in-process stub engine at the same server latency
+ */
+class PoolSizeLoadTest {
+
+    private val server = MockWebServer().apply {
+        dispatcher = FixtureDispatcher(SERVER_DELAY_MILLIS)
+        start()
+    }
+
+    @AfterTest
+    fun tearDown() {
+        server.shutdown()
+    }
+
+    @Test
+    fun poolSizeBoundsConnectionsUnderLoad() = runBlocking {
+        for (poolSize in POOL_SIZES) {
+            val pool = ConnectionPoolConfig(maxIdleConnections = poolSize, maxConnectionsPerHost = poolSize)
+            val api = ChuckNorrisApiImpl(ChuckNorrisApiConfig(baseUrl = server.url("/jokes").toString(), connectionPool = pool))
+            val (report, stats) = try {
+                LoadGenerator(ChuckNorrisClientFactory(api).create())
+                    .run(Workload.ClosedLoop(CONCURRENCY, TOTAL_CALLS), "okhttp pool=$poolSize") to api.connectionStats()!!
+            } finally {
+                api.close()
+            }
+
+            BenchmarkLog.append(
+                "load-pool-okhttp",
+                report.metrics() + mapOf(
+                    "maxConnectionsPerHost" to poolSize,
+                    "connectionsEstablished" to stats.connectionsEstablished
+                )
+            )
+            assertEquals(TOTAL_CALLS, report.completed)
+            assertEquals(0, report.errors)
+            assertTrue(stats.connectionsEstablished <= poolSize, "connections for pool $poolSize: ${stats.connectionsEstablished}")
+        }
+
+        val stub = ChuckNorrisStubServer(
+            StubServerConfig(
+                randomLatency = LatencyDistribution.Fixed(SERVER_DELAY_MILLIS.milliseconds),
+                categoriesLatency = LatencyDistribution.Fixed(SERVER_DELAY_MILLIS.milliseconds),
+                searchLatency = LatencyDistribution.Fixed(SERVER_DELAY_MILLIS.milliseconds)
+            )
+        )
+        ChuckNorrisClientFactory(ChuckNorrisApiConfig(baseUrl = stub.baseUrl, engineFactory = stub.engineFactory())).use {
+            val report = LoadGenerator(it.create()).run(Workload.ClosedLoop(CONCURRENCY, TOTAL_CALLS), "mock engine")
+
+            BenchmarkLog.append("load-pool-mock", report.metrics())
+            assertEquals(TOTAL_CALLS, report.completed)
+            assertEquals(0, report.errors)
+        }
+    }
+
+    private companion object {
+        val POOL_SIZES = listOf(1, 4, 16)
+        const val CONCURRENCY = 16
+        const val TOTAL_CALLS = 200
+        const val SERVER_DELAY_MILLIS = 5L
+    }
+}
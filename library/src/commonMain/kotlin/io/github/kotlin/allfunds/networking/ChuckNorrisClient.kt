@@ -1,39 +1,136 @@
 package io.github.kotlin.allfunds.networking
 
+import io.github.kotlin.allfunds.networking.data.remote.ChuckNorrisApi
+import io.github.kotlin.allfunds.networking.data.remote.ChuckNorrisApiConfig
+import io.github.kotlin.allfunds.networking.data.remote.ChuckNorrisApiImpl
+import io.github.kotlin.allfunds.networking.data.remote.ConnectionStats
+import io.github.kotlin.allfunds.networking.di.ChuckNorrisComponents
 import io.github.kotlin.allfunds.networking.di.KoinInitializer
 import io.github.kotlin.allfunds.networking.domain.model.Joke
+import io.github.kotlin.allfunds.networking.domain.model.JokeSearchResult
+import io.github.kotlin.allfunds.networking.domain.model.SearchProjection
+import io.github.kotlin.allfunds.networking.domain.paging.JokeFeed
+import io.github.kotlin.allfunds.networking.domain.paging.JokePager
+import io.github.kotlin.allfunds.networking.domain.paging.PagingConfig
+import io.github.kotlin.allfunds.networking.domain.repository.JokeRepository
 import io.github.kotlin.allfunds.networking.domain.usecase.GetCategoriesUseCase
 import io.github.kotlin.allfunds.networking.domain.usecase.GetRandomJokeByCategoryUseCase
 import io.github.kotlin.allfunds.networking.domain.usecase.GetRandomJokeUseCase
+import io.github.kotlin.allfunds.networking.domain.usecase.PageJokesUseCase
 import io.github.kotlin.allfunds.networking.domain.usecase.SearchJokesUseCase
+import io.github.kotlin.allfunds.networking.domain.usecase.StreamRandomJokesUseCase
+import io.github.kotlin.allfunds.networking.trace.CallTraceRecorder
+import io.github.kotlin.allfunds.networking.trace.ClientOperation
+import kotlinx.coroutines.CoroutineScope
+import kotlinx.coroutines.Dispatchers
+import kotlinx.coroutines.flow.Flow
+import kotlinx.coroutines.flow.emitAll
+import kotlinx.coroutines.flow.flow
+import kotlinx.coroutines.withContext
+import org.koin.core.Koin
 import org.koin.core.component.KoinComponent
-import org.koin.core.component.inject
+import kotlin.concurrent.atomics.AtomicBoolean
+import kotlin.concurrent.atomics.ExperimentalAtomicApi
+import kotlin.time.Duration
+import kotlin.time.Duration.Companion.seconds
+import kotlin.time.TimeSource
+import kotlin.time.measureTime
+import kotlin.time.measureTimedValue
 
 /**
  * Main client class for the Chuck Norris API
  * 
  * This class provides a simple interface to access Chuck Norris jokes
  * using clean architecture principles with Koin dependency injection.
+ * Clients created by a [ChuckNorrisClientFactory] share directly wired components instead.
+ *
+ * Closing a client makes its calls fail. Only a client created from a [ChuckNorrisApiConfig]
+ * owns its HTTP engine and releases it on close; shared engines are released by their factory
+ * or by [KoinInitializer.close].
  */
-open class ChuckNorrisClient : KoinComponent {
-    
-    // Inject use cases from Koin
-    private val getRandomJokeUseCase: GetRandomJokeUseCase by inject()
-    private val getRandomJokeByCategoryUseCase: GetRandomJokeByCategoryUseCase by inject()
-    private val getCategoriesUseCase: GetCategoriesUseCase by inject()
-    private val searchJokesUseCase: SearchJokesUseCase by inject()
-    
+@OptIn(ExperimentalAtomicApi::class)
+open class ChuckNorrisClient internal constructor(
+    components: Lazy<ChuckNorrisComponents>?,
+    private val ownsComponents: Boolean
+) : KoinComponent, AutoCloseable {
+
+    /**
+     * Client resolving its components from Koin on first use
+     */
+    constructor() : this(null, ownsComponents = false)
+
+    /**
+     * Client with its own API and HTTP engine, released when the client is closed
+     * @param config Configuration of the API
+     */
+    constructor(config: ChuckNorrisApiConfig) : this(
+        lazy { ChuckNorrisComponents.create(ChuckNorrisApiImpl(config)) },
+        ownsComponents = true
+    )
+
+    private val koinBacked = components == null
+    private val closed = AtomicBoolean(false)
+
+    // Resolved on first use, so constructing a client costs nothing
+    private val components: Lazy<ChuckNorrisComponents> =
+        components ?: lazy { ChuckNorrisComponents.from(getKoin()) }
+
+    private val getRandomJokeUseCase: GetRandomJokeUseCase
+        get() = open().getRandomJokeUseCase
+    private val getRandomJokeByCategoryUseCase: GetRandomJokeByCategoryUseCase
+        get() = open().getRandomJokeByCategoryUseCase
+    private val getCategoriesUseCase: GetCategoriesUseCase
+        get() = open().getCategoriesUseCase
+    private val searchJokesUseCase: SearchJokesUseCase
+        get() = open().searchJokesUseCase
+    private val streamRandomJokesUseCase: StreamRandomJokesUseCase
+        get() = open().streamRandomJokesUseCase
+    private val pageJokesUseCase: PageJokesUseCase
+        get() = open().pageJokesUseCase
+
+    private fun open(): ChuckNorrisComponents {
+        check(!closed.load()) { "ChuckNorrisClient is closed" }
+        return components.value
+    }
+
+    /**
+     * Records the sequence and timing of calls when set, off by default
+     */
+    var traceRecorder: CallTraceRecorder? = null
+
+    /**
+     * Koin instance Koin-backed clients resolve their components from, see [KoinInitializer.koin]
+     */
+    override fun getKoin(): Koin = KoinInitializer.koin()
+
     /**
-     * Default constructor that initializes Koin if needed
+     * Prepare everything the first call needs, so it is as fast as later ones
+     *
+     * Runs on [Dispatchers.Default]: creates the API and its HTTP client, resolves the use cases,
+     * loads the serializers and opens keep-alive connections to the API host. Call it early, e.g.
+     * behind a splash screen. Connection failures are reported rather than thrown.
+     * @param connections Number of keep-alive connections to open to the API host
+     * @return Time spent on each part of the warm-up
+     * @throws Exception if the dependencies cannot be resolved
      */
-    constructor() {
+    @Throws(Exception::class)
+    open suspend fun warmUp(connections: Int = 1): WarmUpReport = withContext(Dispatchers.Default) {
+        val start = TimeSource.Monotonic.markNow()
         try {
-            // Only initialize if not already started
-            if (!KoinInitializer.isInitialized()) {
-                KoinInitializer.init()
-            }
-        } catch (e: Exception) {
-            // Koin might already be started in tests, ignore the exception
+            val koinStartup = if (koinBacked && !components.isInitialized()) measureTime { getKoin() } else Duration.ZERO
+            val (wired, dependencyResolution) = measureTimedValue { open() }
+            val apiReport = wired.api.warmUp(connections)
+            WarmUpReport(
+                koinStartup = koinStartup,
+                apiConstruction = apiReport.clientConstruction,
+                dependencyResolution = dependencyResolution,
+                serializers = apiReport.serializers,
+                connections = apiReport.connections,
+                connected = apiReport.connected,
+                total = start.elapsedNow()
+            )
+        } catch (e: Throwable) {
+            throw Exception("Failed to warm up: ${e.message}", e)
         }
     }
     
@@ -44,6 +141,7 @@ open class ChuckNorrisClient : KoinComponent {
      */
     @Throws(Exception::class)
     open suspend fun getRandomJoke(): Joke {
+        traceRecorder?.record(ClientOperation.RANDOM)
         return try {
             getRandomJokeUseCase().getOrThrow()
         } catch (e: Throwable) {
@@ -59,6 +157,7 @@ open class ChuckNorrisClient : KoinComponent {
      */
     @Throws(Exception::class)
     open suspend fun getRandomJokeByCategory(category: String): Joke {
+        traceRecorder?.record(ClientOperation.RANDOM_BY_CATEGORY, category)
         return try {
             getRandomJokeByCategoryUseCase(category).getOrThrow()
         } catch (e: Throwable) {
@@ -66,6 +165,55 @@ open class ChuckNorrisClient : KoinComponent {
         }
     }
     
+    /**
+     * Stream random jokes, e.g. for a ticker
+     *
+     * Cold: nothing is fetched until the flow is collected, and each collection fetches its own
+     * jokes. The next joke is requested while the collector handles the current one, with up to
+     * [prefetch] more kept ready; a slow collector slows the requests down. Cancelling the
+     * collection cancels the request in flight.
+     * @param category Category of the jokes, or null for any
+     * @param targetRate Most jokes requested per second, or null to request them as fast as they are collected
+     * @param prefetch Jokes fetched ahead of the collector
+     * @param dedupWindow Jokes seen this recently are skipped, see [StreamRandomJokesUseCase]
+     * @return Random jokes; the flow fails with the error of the first failed request
+     */
+    open fun randomJokeStream(
+        category: String? = null,
+        targetRate: Double? = null,
+        prefetch: Int = 1,
+        dedupWindow: Int = 50
+    ): Flow<Joke> = flow {
+        // Resolved on collection, so a stream of a closed client fails when collected
+        val jokes = try {
+            streamRandomJokesUseCase(category, targetRate, prefetch, dedupWindow) {
+                // Each request is traced as the single call it stands for
+                if (category == null) {
+                    traceRecorder?.record(ClientOperation.RANDOM)
+                } else {
+                    traceRecorder?.record(ClientOperation.RANDOM_BY_CATEGORY, category)
+                }
+            }
+        } catch (e: Throwable) {
+            throw Exception("Failed to stream random jokes: ${e.message}", e)
+        }
+        emitAll(jokes)
+    }
+
+    /**
+     * Page through random jokes or search results for an infinite list
+     *
+     * Report the joke the list shows with [JokePager.onVisible] and render [JokePager.state];
+     * pages near it are loaded ahead and far ones dropped, see [JokePager].
+     * @param feed The jokes to page through
+     * @param scope Scope the page loads run in, e.g. the screen's scope
+     * @param config Page size, prefetch distance and pages held
+     * @return The pager, which loads nothing until a joke is reported visible
+     * @throws IllegalStateException if the client is closed
+     */
+    open fun jokePager(feed: JokeFeed, scope: CoroutineScope, config: PagingConfig = PagingConfig()): JokePager =
+        pageJokesUseCase(feed, scope, config)
+
     /**
      * Get all available categories
      * @return List of available categories
@@ -73,6 +221,7 @@ open class ChuckNorrisClient : KoinComponent {
      */
     @Throws(Exception::class)
     open suspend fun getCategories(): List<String> {
+        traceRecorder?.record(ClientOperation.CATEGORIES)
         return try {
             getCategoriesUseCase().getOrThrow()
         } catch (e: Throwable) {
@@ -88,10 +237,94 @@ open class ChuckNorrisClient : KoinComponent {
      */
     @Throws(Exception::class)
     open suspend fun searchJokes(query: String): List<Joke> {
+        traceRecorder?.record(ClientOperation.SEARCH, query)
         return try {
             searchJokesUseCase(query).getOrThrow()
         } catch (e: Throwable) {
             throw Exception("Failed to search jokes with query '$query': ${e.message}", e)
         }
     }
+
+    /**
+     * Search for jokes, decoding only the fields the caller needs
+     * @param query The search query (must be at least 3 characters)
+     * @param projection Fields to decode, see [SearchProjection]
+     * @return Total number of matches and the projected jokes
+     * @throws Exception if the request fails
+     */
+    @Throws(Exception::class)
+    open suspend fun searchJokes(query: String, projection: SearchProjection): JokeSearchResult {
+        traceRecorder?.record(ClientOperation.SEARCH, query)
+        return try {
+            searchJokesUseCase(query, projection).getOrThrow()
+        } catch (e: Throwable) {
+            throw Exception("Failed to search jokes with query '$query': ${e.message}", e)
+        }
+    }
+
+    /**
+     * Run several searches at once, e.g. for a related jokes panel
+     *
+     * Identical queries are sent once; a joke found by several queries is one shared [Joke] instance.
+     * @param queries The search queries (each must be at least 3 characters)
+     * @param maxConcurrency Searches sent at once
+     * @return Jokes matching each query, keyed by the query as given
+     * @throws Exception if a search fails
+     */
+    @Throws(Exception::class)
+    open suspend fun searchJokesBatch(
+        queries: List<String>,
+        maxConcurrency: Int = JokeRepository.DEFAULT_BATCH_CONCURRENCY
+    ): Map<String, List<Joke>> {
+        traceRecorder?.record(ClientOperation.SEARCH_BATCH, queries.joinToString("\n"))
+        return try {
+            searchJokesUseCase(queries, maxConcurrency).getOrThrow()
+        } catch (e: Throwable) {
+            throw Exception("Failed to search jokes with queries $queries: ${e.message}", e)
+        }
+    }
+
+    /**
+     * Count the jokes matching a query, without decoding any of them
+     * @param query The search query (must be at least 3 characters)
+     * @return Total number of matches
+     * @throws Exception if the request fails
+     */
+    @Throws(Exception::class)
+    open suspend fun countJokes(query: String): Int = searchJokes(query, SearchProjection.COUNT_ONLY).total
+
+    /**
+     * Connection counters of the HTTP engine, see [ChuckNorrisApi.connectionStats]
+     * @return The counters, or null before the first call or when the engine does not report them
+     */
+    open fun connectionStats(): ConnectionStats? =
+        if (components.isInitialized()) components.value.api.connectionStats() else null
+
+    /**
+     * Close the client; calls made afterwards fail
+     *
+     * A client that owns its API also stops it: calls in flight complete, then the HTTP engine,
+     * its connection pool and its threads are released.
+     */
+    override fun close() {
+        closed.store(true)
+        if (ownsComponents && components.isInitialized()) components.value.api.close()
+    }
+
+    /**
+     * Close the client, giving the calls in flight up to [gracePeriod] to complete before they
+     * are cancelled
+     * @param gracePeriod Time the calls in flight are given to complete
+     */
+    open suspend fun shutdown(gracePeriod: Duration = DEFAULT_GRACE_PERIOD) {
+        closed.store(true)
+        if (ownsComponents && components.isInitialized()) components.value.api.shutdown(gracePeriod)
+    }
+
+    companion object {
+        /**
+         * Grace period of [shutdown] when none is given
+         */
+        val DEFAULT_GRACE_PERIOD: Duration = 5.seconds
+    }
 }
\ No newline at end of file
@@ -0,0 +1,54 @@
+package io.github.kotlin.allfunds.networking
+
+import io.github.kotlin.allfunds.networking.data.remote.ChuckNorrisApi
+import io.github.kotlin.allfunds.networking.data.remote.ChuckNorrisApiConfig
+import io.github.kotlin.allfunds.networking.data.remote.ChuckNorrisApiImpl
+import io.github.kotlin.allfunds.networking.di.ChuckNorrisComponents
+import kotlin.time.Duration
+
+/**
+ * Builds [ChuckNorrisClient]s without Koin or any other global state
+ *
+ * The API, repository and use cases are wired once, on the first call, and shared by every
+ * client the factory creates, so creating a client only allocates the handle. Separate
+ * factories are fully isolated from each other. Closing a client only closes that handle;
+ * closing the factory releases the API it created.
+ */
+class ChuckNorrisClientFactory private constructor(
+    private val components: Lazy<ChuckNorrisComponents>,
+    private val ownsApi: Boolean
+) : AutoCloseable {
+    /**
+     * Factory for clients of the API configured by [config], owned by the factory
+     */
+    constructor(config: ChuckNorrisApiConfig = ChuckNorrisApiConfig()) : this(
+        lazy { ChuckNorrisComponents.create(ChuckNorrisApiImpl(config)) },
+        ownsApi = true
+    )
+
+    /**
+     * Factory for clients of an existing [api], which the caller keeps ownership of
+     */
+    constructor(api: ChuckNorrisApi) : this(lazyOf(ChuckNorrisComponents.create(api)), ownsApi = false)
+
+    /**
+     * Create a client handle sharing this factory's components
+     */
+    fun create(): ChuckNorrisClient = ChuckNorrisClient(components, ownsComponents = false)
+
+    /**
+     * Release the API created by this factory once its calls in flight complete
+     */
+    override fun close() {
+        if (ownsApi && components.isInitialized()) components.value.api.close()
+    }
+
+    /**
+     * Release the API created by this factory, giving the calls in flight up to [gracePeriod]
+     * to complete before they are cancelled
+     * @param gracePeriod Time the calls in flight are given to complete
+     */
+    suspend fun shutdown(gracePeriod: Duration = ChuckNorrisClient.DEFAULT_GRACE_PERIOD) {
+        if (ownsApi && components.isInitialized()) components.value.api.shutdown(gracePeriod)
+    }
+}
@@ -0,0 +1,24 @@
+package io.github.kotlin.allfunds.networking
+
+import kotlin.time.Duration
+
+/**
+ * Breakdown of the time spent by [ChuckNorrisClient.warmUp]
+ *
+ * @property koinStartup Creating the Koin container, zero for factory-built clients or when already running
+ * @property apiConstruction Creating the HTTP client and its engine
+ * @property dependencyResolution Wiring or resolving the API, repository and use cases
+ * @property serializers Loading the serializers and JSON decoders
+ * @property connections Opening keep-alive connections to the API host, including DNS, TCP and TLS
+ * @property connected Whether every connection could be opened
+ * @property total Wall time of the whole warm-up
+ */
+data class WarmUpReport(
+    val koinStartup: Duration,
+    val apiConstruction: Duration,
+    val dependencyResolution: Duration,
+    val serializers: Duration,
+    val connections: Duration,
+    val connected: Boolean,
+    val total: Duration
+)
@@ -0,0 +1,32 @@
+package io.github.kotlin.allfunds.networking.data.remote
+
+import kotlin.time.Duration
+
+/**
+ * Timing of one completed API call
+ *
+ * @property path Endpoint path below the base URL, e.g. `/search`
+ * @property network Time from sending the request to receiving the whole body
+ * @property decode Time spent decoding and mapping the body
+ * @property responseBytes Size of the body after decompression
+ * @property wireBytes Size of the body as received, smaller than [responseBytes] when it was compressed;
+ * equal to it when the platform engine decompressed the body itself
+ * @property decompression Time spent decompressing the body, part of [network]
+ */
+data class CallTiming(
+    val path: String,
+    val network: Duration,
+    val decode: Duration,
+    val responseBytes: Int,
+    val wireBytes: Int = responseBytes,
+    val decompression: Duration = Duration.ZERO
+)
+
+/**
+ * Receives the timing of every API call that decodes a full response body
+ *
+ * Called on the decode dispatcher or the caller's, so implementations must be quick and thread-safe.
+ */
+fun interface ApiListener {
+    fun onCallCompleted(timing: CallTiming)
+}
@@ -0,0 +1,18 @@
+package io.github.kotlin.allfunds.networking.data.remote
+
+import kotlin.time.Duration
+
+/**
+ * Time spent warming up the API
+ *
+ * @property clientConstruction Creating the HTTP client and its engine, zero if it already existed
+ * @property serializers Loading the serializers and JSON decoders
+ * @property connections Opening keep-alive connections to the API host, including DNS, TCP and TLS
+ * @property connected Whether every connection could be opened
+ */
+data class ApiWarmUpReport(
+    val clientConstruction: Duration,
+    val serializers: Duration,
+    val connections: Duration,
+    val connected: Boolean
+)
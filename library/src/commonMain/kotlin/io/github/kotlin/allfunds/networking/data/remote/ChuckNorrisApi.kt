@@ -2,11 +2,19 @@ package io.github.kotlin.allfunds.networking.data.remote
 
 import io.github.kotlin.allfunds.networking.data.remote.dto.JokeDto
 import io.github.kotlin.allfunds.networking.data.remote.dto.SearchResponseDto
+import io.github.kotlin.allfunds.networking.data.remote.routing.EndpointRouting
+import io.github.kotlin.allfunds.networking.data.remote.routing.EndpointStatus
+import io.github.kotlin.allfunds.networking.data.remote.scheduling.AdmissionControl
+import io.github.kotlin.allfunds.networking.data.remote.scheduling.AdmissionStats
+import io.github.kotlin.allfunds.networking.domain.model.Joke
+import io.github.kotlin.allfunds.networking.domain.model.JokeSearchResult
+import io.github.kotlin.allfunds.networking.domain.model.SearchProjection
+import kotlin.time.Duration
 
 /**
  * Interface for the Chuck Norris API
  */
-interface ChuckNorrisApi {
+interface ChuckNorrisApi : AutoCloseable {
     /**
      * Get a random joke
      * @throws Exception if the request fails
@@ -36,4 +44,79 @@ interface ChuckNorrisApi {
      */
     @Throws(Exception::class)
     suspend fun searchJokes(query: String): SearchResponseDto
+
+    /**
+     * Search for jokes, decoded straight into domain jokes
+     * @param query The search query
+     * @throws Exception if the request fails
+     */
+    @Throws(Exception::class)
+    suspend fun searchJokeList(query: String): List<Joke> = searchJokes(query).toDomain()
+
+    /**
+     * Search for jokes, reusing the jokes the caller already holds
+     *
+     * Implementations may skip decoding a joke [known] answers for.
+     * @param query The search query
+     * @param known The joke the caller already holds for an id, or null
+     * @throws Exception if the request fails
+     */
+    @Throws(Exception::class)
+    suspend fun searchJokeList(query: String, known: (id: String) -> Joke?): List<Joke> =
+        searchJokeList(query).map { known(it.id) ?: it }
+
+    /**
+     * Search for jokes, decoding only the fields of [projection]
+     * @param query The search query
+     * @param projection Fields the caller needs
+     * @throws Exception if the request fails
+     */
+    @Throws(Exception::class)
+    suspend fun searchJokes(query: String, projection: SearchProjection): JokeSearchResult {
+        val response = searchJokes(query)
+        val jokes = if (projection == SearchProjection.COUNT_ONLY) emptyList() else response.toDomain()
+        return JokeSearchResult(response.total, jokes)
+    }
+
+    /**
+     * Load serializers and open connections ahead of the first call; never fails
+     * @param connections Number of keep-alive connections to open to the API host
+     * @return Time spent on each part of the warm-up
+     */
+    suspend fun warmUp(connections: Int = 1): ApiWarmUpReport =
+        ApiWarmUpReport(
+            clientConstruction = Duration.ZERO,
+            serializers = Duration.ZERO,
+            connections = Duration.ZERO,
+            connected = false
+        )
+
+    /**
+     * Scores of the API endpoints, see [EndpointRouting]
+     * @return One status per endpoint, empty when there is a single endpoint
+     */
+    suspend fun endpointStatus(): List<EndpointStatus> = emptyList()
+
+    /**
+     * Queue counters of the API endpoints, see [AdmissionControl]
+     * @return One entry per endpoint, empty without admission control
+     */
+    suspend fun admissionStats(): List<AdmissionStats> = emptyList()
+
+    /**
+     * Connection counters of the HTTP engine
+     * @return The counters, or null when the engine does not report them
+     */
+    fun connectionStats(): ConnectionStats? = null
+
+    /**
+     * Stop accepting calls and release the HTTP engine once the calls in flight complete
+     */
+    override fun close() {}
+
+    /**
+     * [close], then wait up to [gracePeriod] for the calls in flight before cancelling them
+     * @param gracePeriod Time the calls in flight are given to complete
+     */
+    suspend fun shutdown(gracePeriod: Duration) = close()
 }
\ No newline at end of file
@@ -0,0 +1,76 @@
+package io.github.kotlin.allfunds.networking.data.remote
+
+import io.github.kotlin.allfunds.networking.data.remote.decode.ByteBufferPool
+import io.github.kotlin.allfunds.networking.data.remote.recording.ExchangeRecorder
+import io.github.kotlin.allfunds.networking.data.remote.routing.EndpointRouting
+import io.github.kotlin.allfunds.networking.data.remote.scheduling.AdaptiveConcurrencyLimiter
+import io.github.kotlin.allfunds.networking.data.remote.scheduling.AdmissionControl
+import io.github.kotlin.allfunds.networking.data.remote.scheduling.RequestScheduler
+import io.github.kotlin.allfunds.networking.data.remote.scheduling.RequestScheduling
+import io.github.kotlin.allfunds.networking.data.remote.slo.SloController
+import io.ktor.client.engine.HttpClientEngineConfig
+import io.ktor.client.engine.HttpClientEngineFactory
+import kotlinx.coroutines.CoroutineDispatcher
+import kotlinx.coroutines.Dispatchers
+import kotlin.time.Duration
+
+/**
+ * Configuration for the Chuck Norris API
+ *
+ * @property baseUrl Base URL of the jokes endpoints, without a trailing slash
+ * @property engineFactory HTTP engine used by the client, or null for the platform default engine
+ * @property recorder Captures every exchange when set, see [ExchangeRecorder]
+ * @property textDecoding How joke texts of search results are decoded
+ * @property bufferPool Search responses are streamed into buffers from this pool when set, see [ByteBufferPool]
+ * @property connectionPool Connection pool of the platform engine, ignored with a custom [engineFactory]
+ * @property connectTimeout Maximum time to establish a connection, or null for the engine default
+ * @property requestTimeout Maximum time for a whole request, or null for no limit
+ * @property maxConcurrentRequests Calls this API runs at once; further calls wait for a slot
+ * @property decodeDispatcher Dispatcher for decoding and mapping responses, or null to decode on the caller's
+ * @property listener Receives the network and decode time of every call that decodes a full body, when set
+ * @property scheduler Orders calls by their [RequestScheduling] and limits them per host when set
+ * @property concurrencyLimiter Adapts the calls in flight to the API's latency when set
+ * @property responseCompression Ask for gzip or deflate bodies and decompress them while they stream into
+ * the decoder; not applied while recording. When off, bodies are asked for uncompressed, so
+ * [CallTiming.wireBytes] stays accurate. NSURLSession always negotiates compression by itself.
+ * @property routing Mirrors of [baseUrl] and how calls are spread and failed over between them
+ * @property admission Bounds the calls waiting for each endpoint and sheds the rest when set
+ * @property slo Answers operations that break their latency or error budget from the API's last
+ * answers when set, see [SloController]
+ */
+data class ChuckNorrisApiConfig(
+    val baseUrl: String = DEFAULT_BASE_URL,
+    val engineFactory: HttpClientEngineFactory<HttpClientEngineConfig>? = null,
+    val recorder: ExchangeRecorder? = null,
+    val textDecoding: TextDecoding = TextDecoding.EAGER,
+    val bufferPool: ByteBufferPool? = null,
+    val connectionPool: ConnectionPoolConfig = ConnectionPoolConfig(),
+    val connectTimeout: Duration? = null,
+    val requestTimeout: Duration? = null,
+    val maxConcurrentRequests: Int = Int.MAX_VALUE,
+    val decodeDispatcher: CoroutineDispatcher? = DEFAULT_DECODE_DISPATCHER,
+    val listener: ApiListener? = null,
+    val scheduler: RequestScheduler? = null,
+    val concurrencyLimiter: AdaptiveConcurrencyLimiter? = null,
+    val responseCompression: Boolean = true,
+    val routing: EndpointRouting = EndpointRouting(),
+    val admission: AdmissionControl? = null,
+    val slo: SloController? = null
+) {
+    init {
+        require(maxConcurrentRequests > 0) { "maxConcurrentRequests must be positive" }
+    }
+
+    companion object {
+        /**
+         * Base URL of the public Chuck Norris API
+         */
+        const val DEFAULT_BASE_URL = "https://api.chucknorris.io/jokes"
+
+        /**
+         * Default decode dispatcher, shared by all APIs: two threads of [Dispatchers.Default],
+         * so decoding never runs on the caller's thread and cannot take over the whole pool
+         */
+        val DEFAULT_DECODE_DISPATCHER: CoroutineDispatcher = Dispatchers.Default.limitedParallelism(2)
+    }
+}
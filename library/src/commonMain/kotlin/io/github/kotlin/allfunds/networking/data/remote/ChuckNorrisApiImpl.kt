@@ -1,28 +1,331 @@
 package io.github.kotlin.allfunds.networking.data.remote
 
+import io.github.kotlin.allfunds.networking.data.remote.decode.ByteArraySource
+import io.github.kotlin.allfunds.networking.data.remote.decode.ByteBufferPool
+import io.github.kotlin.allfunds.networking.data.remote.decode.JokeJsonDecoder
+import io.github.kotlin.allfunds.networking.data.remote.decode.ReceivedBody
+import io.github.kotlin.allfunds.networking.data.remote.decode.decodableContentEncodings
+import io.github.kotlin.allfunds.networking.data.remote.decode.decodeBody
+import io.github.kotlin.allfunds.networking.data.remote.decode.decodeBodyPrefix
 import io.github.kotlin.allfunds.networking.data.remote.dto.JokeDto
 import io.github.kotlin.allfunds.networking.data.remote.dto.SearchResponseDto
+import io.github.kotlin.allfunds.networking.data.remote.routing.Endpoint
+import io.github.kotlin.allfunds.networking.data.remote.routing.EndpointSelector
+import io.github.kotlin.allfunds.networking.data.remote.routing.EndpointStatus
+import io.github.kotlin.allfunds.networking.data.remote.scheduling.AdmissionQueue
+import io.github.kotlin.allfunds.networking.data.remote.scheduling.AdmissionStats
+import io.github.kotlin.allfunds.networking.data.remote.scheduling.RequestScheduling
+import io.github.kotlin.allfunds.networking.data.remote.slo.FallbackStore
+import io.github.kotlin.allfunds.networking.domain.model.Joke
+import io.github.kotlin.allfunds.networking.domain.model.JokeSearchResult
+import io.github.kotlin.allfunds.networking.domain.model.SearchProjection
 import io.ktor.client.*
 import io.ktor.client.call.*
+import io.ktor.client.plugins.*
 import io.ktor.client.plugins.contentnegotiation.*
 import io.ktor.client.request.*
+import io.ktor.client.statement.*
+import io.ktor.http.HttpHeaders
 import io.ktor.serialization.kotlinx.json.*
+import kotlinx.coroutines.CancellationException
+import kotlinx.coroutines.NonCancellable
+import kotlinx.coroutines.async
+import kotlinx.coroutines.awaitAll
+import kotlinx.coroutines.cancel
+import kotlinx.coroutines.coroutineScope
+import kotlinx.coroutines.currentCoroutineContext
+import kotlinx.coroutines.flow.MutableStateFlow
+import kotlinx.coroutines.flow.first
+import kotlinx.coroutines.flow.update
+import kotlinx.coroutines.sync.Semaphore
+import kotlinx.coroutines.sync.withPermit
+import kotlinx.coroutines.withContext
+import kotlinx.coroutines.withTimeoutOrNull
+import kotlinx.io.buffered
+import kotlinx.serialization.DeserializationStrategy
+import kotlinx.serialization.builtins.ListSerializer
+import kotlinx.serialization.builtins.serializer
 import kotlinx.serialization.json.Json
+import kotlinx.serialization.json.io.decodeFromSource
+import kotlin.concurrent.atomics.AtomicBoolean
+import kotlin.concurrent.atomics.ExperimentalAtomicApi
+import kotlin.time.Duration
+import kotlin.time.TimeMark
+import kotlin.time.TimeSource
+import kotlin.time.measureTime
+import kotlin.time.measureTimedValue
 
 /**
  * Implementation of the Chuck Norris API
  *
+ * Owns its HTTP client: [close] or [shutdown] it to release the engine, its connection pool
+ * and its threads. Response bodies are received on the caller's dispatcher and decoded on
+ * [ChuckNorrisApiConfig.decodeDispatcher].
+ *
+ * @param config Base URL, HTTP engine, decoding options and optional exchange recorder
  */
-class ChuckNorrisApiImpl() : ChuckNorrisApi {
-    private val baseUrl = "https://api.chucknorris.io/jokes"
+@OptIn(ExperimentalAtomicApi::class)
+class ChuckNorrisApiImpl(
+    private val config: ChuckNorrisApiConfig = ChuckNorrisApiConfig()
+) : ChuckNorrisApi {
+    private val baseUrl = config.baseUrl
+
+    // Without mirrors every call goes to the base URL, with no scoring
+    private val selector = config.routing.mirrors.takeIf { it.isNotEmpty() }?.let {
+        EndpointSelector(listOf(baseUrl) + it, config.routing)
+    }
+    private val primary = Endpoint(baseUrl)
+
+    private val admissionQueues = config.admission?.let { control ->
+        (listOf(baseUrl) + config.routing.mirrors).distinct().associateWith { AdmissionQueue(it, control) }
+    }
+
+    private val json = Json {
+        ignoreUnknownKeys = true
+        coerceInputValues = true
+        isLenient = true
+    }
+
+    // Created on first use, so resolving the API does not start an engine
+    private val clientHolder = lazy { createClient() }
+    private val client: HttpClient
+        get() {
+            val current = clientHolder.value.client
+            // close() finds no client while one is still being created, so it is closed here
+            if (closed.load()) current.close()
+            return current
+        }
 
-    private val client = HttpClient {
+    // Without a shared pool, every body gets its own buffer that is dropped after decoding
+    private val bodyPool = config.bufferPool ?: ByteBufferPool(bufferSize = UNPOOLED_BUFFER_SIZE, capacity = 0)
+
+    private val closed = AtomicBoolean(false)
+    private val inFlight = MutableStateFlow(0)
+
+    private val concurrency = config.maxConcurrentRequests.takeIf { it < Int.MAX_VALUE }?.let { Semaphore(it) }
+
+    // Last answers of the API, only kept while an SLO can degrade an operation to them
+    private val fallback = config.slo?.let { FallbackStore() }
+
+    private fun createClient(): PlatformHttpClient {
+        val engineFactory = config.engineFactory
+        return if (engineFactory != null) {
+            PlatformHttpClient(HttpClient(engineFactory) { configure() }) { null }
+        } else {
+            platformHttpClient(config.connectionPool) { configure() }
+        }
+    }
+
+    private fun HttpClientConfig<*>.configure() {
         install(ContentNegotiation) {
-            json(Json {
-                ignoreUnknownKeys = true
-                coerceInputValues = true
-                isLenient = true
-            })
+            json(json)
+        }
+        // Recorded bodies are stored as text, so recording turns compression off. Off, the body is
+        // asked for uncompressed, or OkHttp would still negotiate gzip and decode it unseen
+        if (decodableContentEncodings.isNotEmpty()) {
+            val compressed = config.responseCompression && config.recorder == null
+            install(DefaultRequest) {
+                header(HttpHeaders.AcceptEncoding, if (compressed) decodableContentEncodings.joinToString(", ") else "identity")
+            }
+        }
+        if (config.connectTimeout != null || config.requestTimeout != null) {
+            install(HttpTimeout) {
+                connectTimeoutMillis = config.connectTimeout?.inWholeMilliseconds
+                requestTimeoutMillis = config.requestTimeout?.inWholeMilliseconds
+            }
+        }
+    }
+
+    /**
+     * Run [call] under the [ChuckNorrisApiConfig.slo] of [operation], keeping its answers for the
+     * degraded periods of the operation
+     * @param operation Path the SLO samples the call under
+     * @param local The kept answer for this call, or null when there is none
+     * @param keep Keeps a fresh answer of [call]
+     */
+    private suspend fun <T : Any> degradable(
+        operation: String,
+        local: suspend FallbackStore.() -> T?,
+        keep: suspend FallbackStore.(T) -> Unit,
+        call: suspend () -> T
+    ): T {
+        val slo = config.slo ?: return call()
+        val store = fallback!!
+        return slo.guard(operation, { store.local() }, ::isEndpointFailure) { call().also { store.keep(it) } }
+    }
+
+    /**
+     * Run one API call, counted as in flight until it returns
+     *
+     * Waits for a slot first when [ChuckNorrisApiConfig.maxConcurrentRequests] calls are running,
+     * then picks the endpoint, then passes the endpoint's admission queue, the scheduler and the
+     * concurrency limiter when they are configured.
+     * @param call The call, made against the endpoint it is given
+     * @throws IllegalStateException if the API is closed
+     */
+    private suspend fun <T> tracked(call: suspend (Endpoint) -> T): T {
+        inFlight.update { it + 1 }
+        try {
+            check(!closed.load()) { "ChuckNorrisApi is closed" }
+            val limit = concurrency ?: return routed(call)
+            return limit.withPermit { routed(call) }
+        } finally {
+            inFlight.update { it - 1 }
+        }
+    }
+
+    /**
+     * Run [call] on the best endpoint, failing over to the next best while the endpoints fail or
+     * their admission queues shed the call
+     *
+     * The latency an endpoint is scored by runs from the moment the request is sent, so the time
+     * the call waited in local queues does not count against the endpoint.
+     * @throws Throwable the error of the last endpoint tried
+     */
+    private suspend fun <T> routed(call: suspend (Endpoint) -> T): T {
+        val selector = selector ?: return admitted(primary) { scheduled(primary) { call(primary) } }
+        val tried = HashSet<Endpoint>()
+        var failure: Throwable? = null
+        while (true) {
+            val endpoint = selector.select(tried) ?: throw failure!!
+            tried += endpoint
+            var queued = true
+            var sent: TimeMark? = null
+            try {
+                val result = admitted(endpoint) {
+                    queued = false
+                    scheduled(endpoint) {
+                        sent = TimeSource.Monotonic.markNow()
+                        call(endpoint)
+                    }
+                }
+                selector.record(endpoint, sent?.elapsedNow(), failed = false)
+                return result
+            } catch (e: CancellationException) {
+                withContext(NonCancellable) { selector.record(endpoint, latency = null, failed = false) }
+                throw e
+            } catch (e: RequestRejectedException) {
+                selector.record(endpoint, latency = null, failed = false)
+                // A full or backed up queue only says this endpoint is busy, another may have room
+                if (!queued || e.reason == RequestRejectedException.Reason.QUEUE_TIMEOUT) throw e
+                failure = e
+            } catch (e: Throwable) {
+                val endpointFailed = isEndpointFailure(e)
+                selector.record(endpoint, if (endpointFailed) null else sent?.elapsedNow(), endpointFailed)
+                if (!endpointFailed) throw e
+                failure = e
+            }
+        }
+    }
+
+    /**
+     * Run [call] once the admission queue of [endpoint] admits it, see [ChuckNorrisApiConfig.admission]
+     * @throws RequestRejectedException if the queue sheds the call
+     */
+    private suspend fun <T> admitted(endpoint: Endpoint, call: suspend () -> T): T {
+        val queue = admissionQueues?.get(endpoint.baseUrl) ?: return call()
+        return queue.run(call)
+    }
+
+    /**
+     * Run [call] through the scheduler, with the [RequestScheduling] of the caller's context
+     */
+    private suspend fun <T> scheduled(endpoint: Endpoint, call: suspend () -> T): T {
+        val scheduler = config.scheduler ?: return limited(call)
+        val scheduling = currentCoroutineContext()[RequestScheduling] ?: RequestScheduling.DEFAULT
+        return scheduler.run(endpoint.host, scheduling) { limited(call) }
+    }
+
+    /**
+     * Run [call] through the concurrency limiter, innermost so it measures the API and not local queuing
+     * @throws RequestRejectedException if the limiter cannot take the call
+     */
+    private suspend fun <T> limited(call: suspend () -> T): T {
+        val limiter = config.concurrencyLimiter ?: return call()
+        return limiter.run(call)
+    }
+
+    /**
+     * Send a GET request to a path below the base URL of [endpoint]
+     * @param path Endpoint path, starting with a slash
+     * @param block Additional request configuration
+     */
+    private suspend fun get(endpoint: Endpoint, path: String, block: HttpRequestBuilder.() -> Unit = {}): HttpResponse {
+        val url = endpoint.baseUrl + path
+        val recorder = config.recorder ?: return client.get(url, block)
+        val mark = TimeSource.Monotonic.markNow()
+        val response = client.get(url, block)
+        recorder.record(response, mark.elapsedNow())
+        return response
+    }
+
+    /**
+     * Send a GET request as a streaming statement, so the body is not saved on the call
+     * @param path Endpoint path, starting with a slash
+     * @param block Additional request configuration
+     * @param read Consumer of the response, which must read the body before returning
+     */
+    private suspend fun <T> getStreaming(
+        endpoint: Endpoint,
+        path: String,
+        block: HttpRequestBuilder.() -> Unit,
+        read: suspend (HttpResponse) -> T
+    ): T {
+        // The recorder reads the saved body, so recorded calls cannot stream
+        if (config.recorder != null) return read(get(endpoint, path, block))
+        return client.prepareGet(endpoint.baseUrl + path, block).execute { response -> read(response) }
+    }
+
+    /**
+     * Send a GET request and decode the whole body with [deserializer], reading it from the buffer
+     * rather than copying it into a String
+     * @param path Endpoint path, starting with a slash
+     * @param deserializer Deserializer of the response body
+     * @param block Additional request configuration
+     */
+    private suspend fun <T> fetch(
+        endpoint: Endpoint,
+        path: String,
+        deserializer: DeserializationStrategy<T>,
+        block: HttpRequestBuilder.() -> Unit = {}
+    ): T = receive(endpoint, path, block) { bytes, length ->
+        json.decodeFromSource(deserializer, ByteArraySource(bytes, 0, length).buffered())
+    }
+
+    /**
+     * Send a GET request, stream its body into a buffer, decompressing it if needed, then decode
+     * it on the decode dispatcher and report the call's timing to the listener
+     * @param path Endpoint path, starting with a slash
+     * @param block Additional request configuration
+     * @param decode Parser of the first `length` bytes of the buffer
+     */
+    private suspend fun <T> receive(
+        endpoint: Endpoint,
+        path: String,
+        block: HttpRequestBuilder.() -> Unit,
+        decode: suspend (bytes: ByteArray, length: Int) -> T
+    ): T {
+        val start = TimeSource.Monotonic.markNow()
+        val received = ReceivedBody()
+        return getStreaming(endpoint, path, block) { response ->
+            bodyPool.decodeBody(response, received) { bytes, length ->
+                val network = start.elapsedNow()
+                val (value, decodeTime) = measureTimedValue {
+                    val dispatcher = config.decodeDispatcher
+                    if (dispatcher == null) decode(bytes, length) else withContext(dispatcher) { decode(bytes, length) }
+                }
+                config.listener?.onCallCompleted(
+                    CallTiming(
+                        path = path,
+                        network = network,
+                        decode = decodeTime,
+                        responseBytes = received.bytes,
+                        wireBytes = received.wireBytes,
+                        decompression = received.decompression
+                    )
+                )
+                value
+            }
         }
     }
 
@@ -33,7 +336,9 @@ class ChuckNorrisApiImpl() : ChuckNorrisApi {
     @Throws(Exception::class)
     override suspend fun getRandomJoke(): JokeDto {
         return try {
-            client.get("$baseUrl/random").body()
+            degradable("/random", { randomJoke() }, { keepJoke(it) }) {
+                tracked { fetch(it, "/random", JokeDto.serializer()) }
+            }
         } catch (e: Throwable) {
             throw Exception("Failed to get random joke: ${e.message}", e)
         }
@@ -47,9 +352,13 @@ class ChuckNorrisApiImpl() : ChuckNorrisApi {
     @Throws(Exception::class)
     override suspend fun getRandomJokeByCategory(category: String): JokeDto {
         return try {
-            client.get("$baseUrl/random") {
-                parameter("category", category)
-            }.body()
+            degradable("/random", { randomJoke(category) }, { keepJoke(it) }) {
+                tracked { endpoint ->
+                    fetch(endpoint, "/random", JokeDto.serializer()) {
+                        parameter("category", category)
+                    }
+                }
+            }
         } catch (e: Throwable) {
             throw Exception("Failed to get random joke by category '$category': ${e.message}", e)
         }
@@ -62,7 +371,9 @@ class ChuckNorrisApiImpl() : ChuckNorrisApi {
     @Throws(Exception::class)
     override suspend fun getCategories(): List<String> {
         return try {
-            client.get("$baseUrl/categories").body()
+            degradable("/categories", { categories() }, { keepCategories(it) }) {
+                tracked { fetch(it, "/categories", ListSerializer(String.serializer())) }
+            }
         } catch (e: Throwable) {
             throw Exception("Failed to get categories: ${e.message}", e)
         }
@@ -76,11 +387,181 @@ class ChuckNorrisApiImpl() : ChuckNorrisApi {
     @Throws(Exception::class)
     override suspend fun searchJokes(query: String): SearchResponseDto {
         return try {
-            client.get("$baseUrl/search") {
-                parameter("query", query)
-            }.body()
+            degradable("/search", { searchResponse(query) }, { keepSearch(query, it) }) {
+                tracked { endpoint ->
+                    fetch(endpoint, "/search", SearchResponseDto.serializer()) {
+                        parameter("query", query)
+                    }
+                }
+            }
+        } catch (e: Throwable) {
+            throw Exception("Failed to search jokes with query '$query': ${e.message}", e)
+        }
+    }
+
+    /**
+     * Search for jokes, decoded straight into domain jokes
+     *
+     * The decode suspends between chunks of jokes, so a large response shares the decode
+     * dispatcher fairly. With [TextDecoding.LAZY], the joke texts stay UTF-8 until read. With
+     * a buffer pool, the response is decoded straight from the pooled buffer it is received into.
+     * @param query The search query
+     * @throws Exception if the request fails
+     */
+    @Throws(Exception::class)
+    override suspend fun searchJokeList(query: String): List<Joke> {
+        return try {
+            searchDegradable(query, SearchProjection.FULL).jokes
         } catch (e: Throwable) {
             throw Exception("Failed to search jokes with query '$query': ${e.message}", e)
         }
     }
+
+    /**
+     * [searchJokeList] that skips the jokes [known] holds while decoding, see [JokeJsonDecoder.decodeSearch]
+     * @param query The search query
+     * @param known The joke the caller already holds for an id, or null
+     * @throws Exception if the request fails
+     */
+    @Throws(Exception::class)
+    override suspend fun searchJokeList(query: String, known: (id: String) -> Joke?): List<Joke> {
+        return try {
+            searchDegradable(query, SearchProjection.FULL, known).jokes
+        } catch (e: Throwable) {
+            throw Exception("Failed to search jokes with query '$query': ${e.message}", e)
+        }
+    }
+
+    /**
+     * Search for jokes, decoding only the fields of [projection]
+     *
+     * Skipped fields are never decoded. A [SearchProjection.COUNT_ONLY] search stops decoding
+     * once `total` has arrived and discards the rest of the response, keeping the connection.
+     * @param query The search query
+     * @param projection Fields the caller needs
+     * @throws Exception if the request fails
+     */
+    @Throws(Exception::class)
+    override suspend fun searchJokes(query: String, projection: SearchProjection): JokeSearchResult {
+        return try {
+            searchDegradable(query, projection)
+        } catch (e: Throwable) {
+            throw Exception("Failed to search jokes with query '$query': ${e.message}", e)
+        }
+    }
+
+    private suspend fun searchDegradable(
+        query: String,
+        projection: SearchProjection,
+        known: ((id: String) -> Joke?)? = null
+    ): JokeSearchResult =
+        degradable("/search", { searchResult(query, projection) }, { keepSearch(query, it, projection) }) {
+            tracked { search(it, query, projection, known) }
+        }
+
+    private suspend fun search(
+        endpoint: Endpoint,
+        query: String,
+        projection: SearchProjection,
+        known: ((id: String) -> Joke?)?
+    ): JokeSearchResult {
+        val lazyText = config.textDecoding == TextDecoding.LAZY
+        val block: HttpRequestBuilder.() -> Unit = { parameter("query", query) }
+        if (projection == SearchProjection.COUNT_ONLY) {
+            return getStreaming(endpoint, "/search", block) { response ->
+                val total = bodyPool.decodeBodyPrefix(response) { bytes, length -> JokeJsonDecoder.decodeTotal(bytes, length) }
+                JokeSearchResult(total, emptyList())
+            }
+        }
+        return receive(endpoint, "/search", block) { bytes, length ->
+            JokeJsonDecoder.decodeSearchCooperatively(bytes, length, lazyText, projection, known)
+        }
+    }
+
+    /**
+     * Load the serializers and decoders and open keep-alive connections to the API host
+     *
+     * Connections are opened with HEAD requests and parked in the engine's pool. Failures are
+     * reported in the result rather than thrown, so warm-up can run while offline.
+     * @param connections Number of keep-alive connections to open
+     * @return Time spent on each part of the warm-up
+     */
+    override suspend fun warmUp(connections: Int): ApiWarmUpReport {
+        if (closed.load()) return super.warmUp(connections)
+        val clientConstruction = measureTime { client }
+        val serializers = measureTime {
+            val search = WARM_UP_SEARCH.encodeToByteArray()
+            val categories = WARM_UP_CATEGORIES.encodeToByteArray()
+            json.decodeFromSource(SearchResponseDto.serializer(), ByteArraySource(search, 0, search.size).buffered())
+            json.decodeFromSource(
+                ListSerializer(String.serializer()),
+                ByteArraySource(categories, 0, categories.size).buffered()
+            )
+            JokeJsonDecoder.decodeSearch(search)
+        }
+        val (opened, connectionTime) = measureTimedValue {
+            coroutineScope {
+                List(connections) { async { openConnection() } }.awaitAll()
+            }
+        }
+        return ApiWarmUpReport(clientConstruction, serializers, connectionTime, connected = opened.all { it })
+    }
+
+    private suspend fun openConnection(): Boolean {
+        return try {
+            tracked { client.head("${it.baseUrl}/categories") }
+            true
+        } catch (e: CancellationException) {
+            throw e
+        } catch (e: Throwable) {
+            false
+        }
+    }
+
+    /**
+     * Scores of the base URL and its mirrors
+     * @return One status per endpoint, empty without mirrors
+     */
+    override suspend fun endpointStatus(): List<EndpointStatus> = selector?.status() ?: emptyList()
+
+    /**
+     * Admission counters of the base URL and its mirrors
+     * @return One entry per endpoint, empty without [ChuckNorrisApiConfig.admission]
+     */
+    override suspend fun admissionStats(): List<AdmissionStats> = admissionQueues?.values?.map { it.stats() } ?: emptyList()
+
+    /**
+     * Connection counters of the platform engine
+     * @return The counters, or null before the first call, with a custom engine, or on iOS
+     */
+    override fun connectionStats(): ConnectionStats? =
+        if (clientHolder.isInitialized()) clientHolder.value.connectionStats() else null
+
+    /**
+     * Stop accepting calls and release the HTTP engine once the calls in flight complete
+     *
+     * Calls made after closing fail. Idempotent, and never creates a client that was not used.
+     */
+    override fun close() {
+        if (!closed.compareAndSet(false, true)) return
+        // Ktor lets running calls complete before it shuts the engine down
+        if (clientHolder.isInitialized()) client.close()
+    }
+
+    /**
+     * [close], then wait up to [gracePeriod] for the calls in flight before cancelling them
+     * @param gracePeriod Time the calls in flight are given to complete
+     */
+    override suspend fun shutdown(gracePeriod: Duration) {
+        close()
+        val drained = withTimeoutOrNull(gracePeriod) { inFlight.first { it == 0 } } != null
+        if (!drained && clientHolder.isInitialized()) client.cancel("ChuckNorrisApi shut down")
+    }
+
+    private companion object {
+        const val UNPOOLED_BUFFER_SIZE = 4 * 1024
+        const val WARM_UP_SEARCH = """{"total":1,"result":[{"categories":["dev"],"created_at":"","icon_url":"",""" +
+            """"id":"warm-up","updated_at":"","url":"","value":""}]}"""
+        const val WARM_UP_CATEGORIES = """["dev"]"""
+    }
 }
\ No newline at end of file
@@ -0,0 +1,32 @@
+package io.github.kotlin.allfunds.networking.data.remote
+
+import kotlin.time.Duration
+import kotlin.time.Duration.Companion.minutes
+
+/**
+ * Connection pool of the platform HTTP engine
+ *
+ * Every [ChuckNorrisApiImpl] has its own engine and pool, so these limits bound each instance
+ * separately. Not applied when [ChuckNorrisApiConfig.engineFactory] is set.
+ *
+ * @property maxIdleConnections Idle keep-alive connections kept open (OkHttp only)
+ * @property keepAlive How long an idle connection is kept open (OkHttp only)
+ * @property maxConnectionsPerHost Concurrent connections to the API host
+ * @property maxRequests Requests the engine executes at once, across hosts (OkHttp only)
+ * @property protocol HTTP version spoken to the API host, or null for the engine's own negotiation
+ * @property maxConcurrentStreams Requests multiplexed at once on the HTTP/2 connection to the API host,
+ * in place of [maxConnectionsPerHost] when [protocol] is an HTTP/2 one (OkHttp only). Also bounds the
+ * connections when an [HttpProtocol.HTTP_2] server falls back to HTTP/1.1
+ */
+data class ConnectionPoolConfig(
+    val maxIdleConnections: Int = 5,
+    val keepAlive: Duration = 5.minutes,
+    val maxConnectionsPerHost: Int = 5,
+    val maxRequests: Int = 64,
+    val protocol: HttpProtocol? = null,
+    val maxConcurrentStreams: Int = 5
+) {
+    init {
+        require(maxConcurrentStreams > 0) { "maxConcurrentStreams must be positive" }
+    }
+}
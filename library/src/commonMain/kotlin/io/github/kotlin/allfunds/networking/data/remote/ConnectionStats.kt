@@ -0,0 +1,18 @@
+package io.github.kotlin.allfunds.networking.data.remote
+
+/**
+ * Connection-level counters of the platform engine of one API
+ *
+ * @property openConnections Connections in the pool, busy or idle
+ * @property idleConnections Connections in the pool with no request on them
+ * @property connectionsEstablished Connections opened since the client was created
+ * @property http2Exchanges Requests sent as streams on an HTTP/2 connection
+ * @property http1Exchanges Requests sent on an HTTP/1.x connection
+ */
+data class ConnectionStats(
+    val openConnections: Int,
+    val idleConnections: Int,
+    val connectionsEstablished: Int,
+    val http2Exchanges: Int,
+    val http1Exchanges: Int
+)
@@ -0,0 +1,22 @@
+package io.github.kotlin.allfunds.networking.data.remote
+
+import io.ktor.http.HttpStatusCode
+import kotlinx.serialization.SerializationException
+
+/**
+ * Whether [error] says the endpoint is unhealthy, so another endpoint may succeed; a client
+ * error such as an unknown category would fail on every mirror
+ */
+internal fun isEndpointFailure(error: Throwable): Boolean = when (error) {
+    is RequestRejectedException -> false
+    is UnexpectedStatusException -> error.status.value !in 400..499 ||
+        error.status == HttpStatusCode.RequestTimeout ||
+        error.status == HttpStatusCode.TooManyRequests
+    else -> true
+}
+
+/**
+ * Whether [error] says the API is overloaded: a server error, 408 or 429, a timeout or a broken
+ * connection; a body that fails to decode came back from an API that kept up
+ */
+internal fun isOverload(error: Throwable): Boolean = isEndpointFailure(error) && error !is SerializationException
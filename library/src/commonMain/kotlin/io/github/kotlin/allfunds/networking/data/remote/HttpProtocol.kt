@@ -0,0 +1,21 @@
+package io.github.kotlin.allfunds.networking.data.remote
+
+/**
+ * HTTP version the platform engine speaks to the API host
+ */
+enum class HttpProtocol {
+    /**
+     * HTTP/1.1 only, one request per connection at a time (OkHttp only; NSURLSession always negotiates)
+     */
+    HTTP_1_1,
+
+    /**
+     * HTTP/2 negotiated with ALPN over TLS, falling back to HTTP/1.1 for servers without it
+     */
+    HTTP_2,
+
+    /**
+     * Cleartext HTTP/2 without negotiation (h2c), for local servers known to speak it (OkHttp only)
+     */
+    HTTP_2_PRIOR_KNOWLEDGE
+}
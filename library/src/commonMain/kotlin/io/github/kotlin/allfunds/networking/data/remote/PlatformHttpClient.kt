@@ -0,0 +1,19 @@
+package io.github.kotlin.allfunds.networking.data.remote
+
+import io.ktor.client.HttpClient
+import io.ktor.client.HttpClientConfig
+
+/**
+ * HTTP client on the platform engine, with access to its connection counters
+ * @property client The Ktor client
+ * @property connectionStats Current counters, or null when the engine does not report them
+ */
+internal class PlatformHttpClient(
+    val client: HttpClient,
+    val connectionStats: () -> ConnectionStats?
+)
+
+/**
+ * Create an HTTP client on the platform engine, with its own connection pool sized by [pool]
+ */
+internal expect fun platformHttpClient(pool: ConnectionPoolConfig, block: HttpClientConfig<*>.() -> Unit): PlatformHttpClient
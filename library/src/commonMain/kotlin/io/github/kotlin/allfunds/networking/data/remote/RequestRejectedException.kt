@@ -0,0 +1,28 @@
+package io.github.kotlin.allfunds.networking.data.remote
+
+/**
+ * Thrown when a call is refused before it is sent because the API is at capacity
+ *
+ * The call had no effect, so it is safe to retry later.
+ *
+ * @property reason Why the call was refused
+ */
+class RequestRejectedException(message: String, val reason: Reason) : Exception(message) {
+    enum class Reason {
+        /**
+         * The queue for a slot was full when the call arrived
+         */
+        QUEUE_FULL,
+
+        /**
+         * The call waited longer than allowed for a slot
+         */
+        QUEUE_TIMEOUT,
+
+        /**
+         * The call was shed from a queue that stayed backed up, see
+         * [io.github.kotlin.allfunds.networking.data.remote.scheduling.AdmissionControl.codel]
+         */
+        DROPPED
+    }
+}
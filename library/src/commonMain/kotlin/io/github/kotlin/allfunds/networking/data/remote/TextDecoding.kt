@@ -0,0 +1,17 @@
+package io.github.kotlin.allfunds.networking.data.remote
+
+/**
+ * How joke texts of search results are decoded
+ */
+enum class TextDecoding {
+    /**
+     * Decode every joke text into a [String] while parsing the response
+     */
+    EAGER,
+
+    /**
+     * Keep joke texts as UTF-8 bytes and decode each one on first access of
+     * [io.github.kotlin.allfunds.networking.domain.model.Joke.value]
+     */
+    LAZY
+}
@@ -0,0 +1,9 @@
+package io.github.kotlin.allfunds.networking.data.remote
+
+import io.ktor.http.HttpStatusCode
+
+/**
+ * Thrown when the API answers with a status other than success
+ * @property status The status received
+ */
+internal class UnexpectedStatusException(val status: HttpStatusCode) : IllegalStateException("Unexpected response status $status")
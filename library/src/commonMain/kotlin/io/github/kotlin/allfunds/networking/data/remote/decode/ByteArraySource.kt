@@ -0,0 +1,32 @@
+package io.github.kotlin.allfunds.networking.data.remote.decode
+
+import kotlinx.io.Buffer
+import kotlinx.io.RawSource
+
+/**
+ * Source over the bytes of [bytes] from [startIndex] until [endIndex]
+ *
+ * Lets a pooled buffer be decoded by stream readers, which then hold at most one segment of it
+ * at a time instead of a String of the whole body. The array must not change while it is read.
+ */
+internal class ByteArraySource(
+    private val bytes: ByteArray,
+    startIndex: Int,
+    private val endIndex: Int
+) : RawSource {
+    private var position = startIndex
+
+    init {
+        require(startIndex in 0..endIndex && endIndex <= bytes.size) { "Invalid range $startIndex..$endIndex" }
+    }
+
+    override fun readAtMostTo(sink: Buffer, byteCount: Long): Long {
+        if (position == endIndex) return -1
+        val count = minOf(byteCount, (endIndex - position).toLong()).toInt()
+        sink.write(bytes, position, position + count)
+        position += count
+        return count.toLong()
+    }
+
+    override fun close() {}
+}
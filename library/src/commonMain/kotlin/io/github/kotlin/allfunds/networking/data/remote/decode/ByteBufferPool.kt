@@ -0,0 +1,80 @@
+package io.github.kotlin.allfunds.networking.data.remote.decode
+
+import kotlin.concurrent.atomics.AtomicArray
+import kotlin.concurrent.atomics.AtomicInt
+import kotlin.concurrent.atomics.ExperimentalAtomicApi
+
+/**
+ * Lock-free pool of reusable byte buffers for receiving response bodies
+ *
+ * Buffers larger than [maxRetainedSize] are handed out but never kept, so a single huge
+ * response does not pin its buffer for the lifetime of the pool.
+ *
+ * @param bufferSize Size of newly allocated buffers
+ * @param maxRetainedSize Largest buffer returned to the pool
+ * @param capacity Maximum number of idle buffers kept
+ */
+@OptIn(ExperimentalAtomicApi::class)
+class ByteBufferPool(
+    val bufferSize: Int = DEFAULT_BUFFER_SIZE,
+    val maxRetainedSize: Int = DEFAULT_MAX_RETAINED_SIZE,
+    capacity: Int = DEFAULT_CAPACITY
+) {
+    private val slots = AtomicArray(arrayOfNulls<ByteArray>(capacity))
+    private val allocated = AtomicInt(0)
+    private val reused = AtomicInt(0)
+
+    /**
+     * Number of buffers allocated, either because no idle buffer was large enough or to grow one
+     */
+    val allocations: Int
+        get() = allocated.load()
+
+    /**
+     * Number of buffers served from the pool
+     */
+    val reuses: Int
+        get() = reused.load()
+
+    /**
+     * Take a buffer of at least [minSize] bytes, with unspecified contents
+     */
+    fun acquire(minSize: Int = bufferSize): ByteArray {
+        for (index in 0 until slots.size) {
+            val buffer = slots.loadAt(index) ?: continue
+            if (buffer.size >= minSize && slots.compareAndSetAt(index, buffer, null)) {
+                reused.incrementAndFetch()
+                return buffer
+            }
+        }
+        allocated.incrementAndFetch()
+        return ByteArray(maxOf(minSize, bufferSize))
+    }
+
+    /**
+     * Replace a full buffer taken with [acquire] by one twice its size, keeping its contents
+     *
+     * The smaller buffer is dropped rather than released, so the pool converges on buffers that
+     * fit the typical response.
+     */
+    fun grow(buffer: ByteArray): ByteArray {
+        allocated.incrementAndFetch()
+        return buffer.copyOf(buffer.size * 2)
+    }
+
+    /**
+     * Return a buffer taken with [acquire]; it must not be used afterwards
+     */
+    fun release(buffer: ByteArray) {
+        if (buffer.size < bufferSize || buffer.size > maxRetainedSize) return
+        for (index in 0 until slots.size) {
+            if (slots.compareAndSetAt(index, null, buffer)) return
+        }
+    }
+
+    companion object {
+        const val DEFAULT_BUFFER_SIZE = 16 * 1024
+        const val DEFAULT_MAX_RETAINED_SIZE = 1024 * 1024
+        const val DEFAULT_CAPACITY = 16
+    }
+}
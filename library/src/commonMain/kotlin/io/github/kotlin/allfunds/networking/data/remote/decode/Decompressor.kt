@@ -0,0 +1,47 @@
+package io.github.kotlin.allfunds.networking.data.remote.decode
+
+/**
+ * Streaming decompressor of one response body
+ *
+ * Fed with the compressed bytes as they arrive and drained into the decode buffer, so the
+ * compressed body is never held in full.
+ */
+internal interface Decompressor {
+    /**
+     * Whether the body has been fully decompressed
+     */
+    val finished: Boolean
+
+    /**
+     * Whether [inflate] has consumed all input given so far
+     */
+    fun needsInput(): Boolean
+
+    /**
+     * Hand over the next compressed bytes; [bytes] must not change until [needsInput] is true again
+     */
+    fun setInput(bytes: ByteArray, offset: Int, length: Int)
+
+    /**
+     * Decompress into [output]
+     * @return Number of bytes written, 0 when more input is needed
+     */
+    fun inflate(output: ByteArray, offset: Int, length: Int): Int
+
+    /**
+     * Release native resources; the decompressor cannot be used afterwards
+     */
+    fun end()
+}
+
+/**
+ * Content codings the library decompresses itself on this platform, in order of preference
+ *
+ * Empty when the platform engine negotiates and decodes compression on its own.
+ */
+internal expect val decodableContentEncodings: List<String>
+
+/**
+ * Decompressor for a `Content-Encoding`, or null when the body needs no decoding by the library
+ */
+internal expect fun decompressor(contentEncoding: String): Decompressor?
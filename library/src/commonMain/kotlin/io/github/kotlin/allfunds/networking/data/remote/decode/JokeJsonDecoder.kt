@@ -0,0 +1,196 @@
+package io.github.kotlin.allfunds.networking.data.remote.decode
+
+import io.github.kotlin.allfunds.networking.domain.model.Joke
+import io.github.kotlin.allfunds.networking.domain.model.JokeSearchResult
+import io.github.kotlin.allfunds.networking.domain.model.SearchProjection
+import kotlinx.coroutines.yield
+
+/**
+ * Decodes API joke payloads from UTF-8 bytes straight into domain [Joke]s
+ */
+internal object JokeJsonDecoder {
+    private val searchKeys = JsonByteReader.keys("total", "result")
+    private const val KEY_TOTAL = 0
+    private const val KEY_RESULT = 1
+
+    /**
+     * Jokes decoded between suspension points by [decodeSearchCooperatively]
+     */
+    const val DEFAULT_CHUNK_SIZE = 64
+
+    private val jokeKeys = JsonByteReader.keys("id", "value", "url", "categories")
+    private const val KEY_ID = 0
+    private const val KEY_VALUE = 1
+    private const val KEY_URL = 2
+    private const val KEY_CATEGORIES = 3
+
+    /**
+     * Decode a `/jokes/search` response
+     *
+     * With [lazyText], the joke texts are copied into one shared UTF-8 buffer for the whole
+     * response and decoded to strings only when read; the rest of [bytes] is not retained.
+     * Fields outside [projection] are skipped without being decoded, and a [SearchProjection.COUNT_ONLY]
+     * decode returns as soon as `total` has been read.
+     *
+     * A joke whose id [known] answers for is skipped once its id is read, and the known instance
+     * takes its place; the API sends the id before the text, so the text is never decoded.
+     *
+     * @param bytes Buffer holding the response body
+     * @param length Number of valid bytes in [bytes]
+     * @param lazyText Keep joke texts as UTF-8 until accessed
+     * @param projection Fields to decode
+     * @param known The joke the caller already holds for an id, or null
+     */
+    fun decodeSearch(
+        bytes: ByteArray,
+        length: Int = bytes.size,
+        lazyText: Boolean = false,
+        projection: SearchProjection = SearchProjection.FULL,
+        known: ((id: String) -> Joke?)? = null
+    ): JokeSearchResult = readSearch(bytes, length, lazyText, projection, known) {}
+
+    /**
+     * [decodeSearch] that suspends every [chunkSize] jokes, so a large response does not hold
+     * its thread for the whole decode and can be cancelled midway
+     */
+    suspend fun decodeSearchCooperatively(
+        bytes: ByteArray,
+        length: Int = bytes.size,
+        lazyText: Boolean = false,
+        projection: SearchProjection = SearchProjection.FULL,
+        known: ((id: String) -> Joke?)? = null,
+        chunkSize: Int = DEFAULT_CHUNK_SIZE
+    ): JokeSearchResult = readSearch(bytes, length, lazyText, projection, known) { decoded ->
+        if (decoded % chunkSize == 0) yield()
+    }
+
+    private inline fun readSearch(
+        bytes: ByteArray,
+        length: Int,
+        lazyText: Boolean,
+        projection: SearchProjection,
+        known: ((id: String) -> Joke?)?,
+        afterJoke: (decoded: Int) -> Unit
+    ): JokeSearchResult {
+        val reader = JsonByteReader(bytes, length)
+        var total = 0
+        val pending = ArrayList<PendingJoke>()
+        reader.beginObject()
+        while (true) {
+            when (reader.nextKey(searchKeys)) {
+                JsonByteReader.END -> break
+                KEY_TOTAL -> {
+                    total = reader.readInt()
+                    if (projection == SearchProjection.COUNT_ONLY) break
+                }
+                KEY_RESULT -> if (projection == SearchProjection.COUNT_ONLY) {
+                    reader.skipValue()
+                } else {
+                    reader.beginArray()
+                    while (reader.nextElement()) {
+                        pending += readJoke(reader, lazyText, projection, known)
+                        afterJoke(pending.size)
+                    }
+                }
+                else -> reader.skipValue()
+            }
+        }
+        return JokeSearchResult(total, if (lazyText) buildLazy(bytes, pending) else pending.map { it.eager() })
+    }
+
+    /**
+     * Read `total` from the start of a search response that may still be arriving
+     * @return The total, or null when [bytes] ends before it
+     */
+    fun decodeTotal(bytes: ByteArray, length: Int): Int? = try {
+        decodeSearch(bytes, length, projection = SearchProjection.COUNT_ONLY).total
+    } catch (e: TruncatedJsonException) {
+        null
+    }
+
+    /**
+     * Decode a single joke object, as returned by `/jokes/random`
+     */
+    fun decodeJoke(bytes: ByteArray, length: Int = bytes.size): Joke =
+        readJoke(JsonByteReader(bytes, length), lazyText = false, SearchProjection.FULL, known = null).eager()
+
+    /**
+     * Fields of a joke read from the buffer, before the texts are placed
+     */
+    private class PendingJoke(
+        val id: String,
+        val url: String,
+        val categories: List<String>,
+        val text: String?,
+        val textStart: Int,
+        val textEnd: Int,
+        val known: Joke? = null
+    ) {
+        fun eager(): Joke = known ?: Joke(id = id, value = text ?: "", url = url, categories = categories)
+    }
+
+    private fun readJoke(
+        reader: JsonByteReader,
+        lazyText: Boolean,
+        projection: SearchProjection,
+        known: ((id: String) -> Joke?)?
+    ): PendingJoke {
+        val readText = projection == SearchProjection.IDS_AND_TEXT || projection == SearchProjection.FULL
+        val readAll = projection == SearchProjection.FULL
+        var id = ""
+        var url = ""
+        var categories = emptyList<String>()
+        var text: String? = null
+        var textStart = 0
+        var textEnd = 0
+        reader.beginObject()
+        while (true) {
+            when (reader.nextKey(jokeKeys)) {
+                JsonByteReader.END -> break
+                KEY_ID -> {
+                    id = reader.readString()
+                    val joke = known?.invoke(id)
+                    if (joke != null) {
+                        while (reader.nextKey(jokeKeys) != JsonByteReader.END) reader.skipValue()
+                        return PendingJoke(id, "", emptyList(), null, 0, 0, joke)
+                    }
+                }
+                KEY_URL -> if (readAll) url = reader.readString() else reader.skipValue()
+                KEY_CATEGORIES -> if (readAll) categories = reader.readStringList() else reader.skipValue()
+                KEY_VALUE -> if (!readText) {
+                    reader.skipValue()
+                } else if (!lazyText) {
+                    text = reader.readString()
+                } else if (reader.readStringRange()) {
+                    textStart = reader.rangeStart
+                    textEnd = reader.rangeEnd
+                } else {
+                    // Escaped text has no verbatim UTF-8 slice, decode it now
+                    text = reader.decodeRange()
+                }
+                else -> reader.skipValue()
+            }
+        }
+        // Joke derives the url from the id, so this string is not retained
+        if (!readAll) url = Joke.URL_PREFIX + id
+        return PendingJoke(id, url, categories, text, textStart, textEnd)
+    }
+
+    private fun buildLazy(bytes: ByteArray, pending: List<PendingJoke>): List<Joke> {
+        var size = 0
+        for (joke in pending) {
+            if (joke.text == null && joke.known == null) size += joke.textEnd - joke.textStart
+        }
+        val arena = ByteArray(size)
+        var offset = 0
+        return pending.map { joke ->
+            if (joke.text != null || joke.known != null) {
+                joke.eager()
+            } else {
+                val length = joke.textEnd - joke.textStart
+                bytes.copyInto(arena, offset, joke.textStart, joke.textEnd)
+                Joke(joke.id, arena, offset, length, joke.url, joke.categories).also { offset += length }
+            }
+        }
+    }
+}
@@ -0,0 +1,310 @@
+package io.github.kotlin.allfunds.networking.data.remote.decode
+
+import kotlinx.serialization.SerializationException
+
+/**
+ * Thrown when the document ends before the value being read, so more input may complete it
+ */
+internal class TruncatedJsonException(message: String) : SerializationException(message)
+
+/**
+ * Minimal pull reader over UTF-8 JSON bytes
+ *
+ * Only covers what the joke payloads need, but reads keys and strings straight from the
+ * buffer: keys are matched against byte tables, and string values can be located without
+ * decoding them.
+ *
+ * @param bytes Buffer holding the JSON document
+ * @param end Number of valid bytes in [bytes]
+ */
+internal class JsonByteReader(
+    private val bytes: ByteArray,
+    private val end: Int = bytes.size
+) {
+    /**
+     * Current read position
+     */
+    var position: Int = 0
+        private set
+
+    /**
+     * Start of the last string located with [readStringRange]
+     */
+    var rangeStart: Int = 0
+        private set
+
+    /**
+     * End (exclusive) of the last string located with [readStringRange]
+     */
+    var rangeEnd: Int = 0
+        private set
+
+    private var rangePlain = true
+
+    /**
+     * Whether the document has been fully consumed, ignoring trailing whitespace
+     */
+    val isExhausted: Boolean
+        get() {
+            skipWhitespace()
+            return position >= end
+        }
+
+    fun beginObject() = consume('{')
+
+    fun beginArray() = consume('[')
+
+    /**
+     * Read the next key of the current object
+     * @param keys Candidate keys, as UTF-8 bytes
+     * @return Index of the matching candidate, [UNKNOWN_KEY] for any other key, or [END] when the object is closed
+     */
+    fun nextKey(keys: Array<ByteArray>): Int {
+        if (!nextEntry('}')) return END
+        readStringRange()
+        consume(':')
+        val length = rangeEnd - rangeStart
+        for (index in keys.indices) {
+            val key = keys[index]
+            if (key.size == length && matches(key)) return index
+        }
+        return UNKNOWN_KEY
+    }
+
+    /**
+     * Move to the next element of the current array
+     * @return false once the array is closed
+     */
+    fun nextElement(): Boolean = nextEntry(']')
+
+    /**
+     * Locate the next string value without decoding it
+     * @return true when the string has no escape sequences, so [rangeStart] to [rangeEnd] is its exact UTF-8 text
+     */
+    fun readStringRange(): Boolean {
+        consume('"')
+        rangeStart = position
+        var plain = true
+        while (true) {
+            if (position >= end) throw truncated("unterminated string")
+            val byte = bytes[position]
+            if (byte == QUOTE) break
+            if (byte == BACKSLASH) {
+                plain = false
+                position++
+            }
+            position++
+        }
+        rangeEnd = position
+        rangePlain = plain
+        position++
+        return plain
+    }
+
+    /**
+     * Decode the string last located with [readStringRange]
+     */
+    fun decodeRange(): String =
+        if (rangePlain) bytes.decodeToString(rangeStart, rangeEnd) else unescape(rangeStart, rangeEnd)
+
+    /**
+     * Read and decode the next string value
+     */
+    fun readString(): String {
+        readStringRange()
+        return decodeRange()
+    }
+
+    /**
+     * Read a string value or null
+     */
+    fun readNullableString(): String? {
+        if (peek() == LETTER_N) {
+            skipLiteral()
+            return null
+        }
+        return readString()
+    }
+
+    /**
+     * Read an integer value
+     */
+    fun readInt(): Int {
+        skipWhitespace()
+        var negative = false
+        if (position < end && bytes[position] == MINUS) {
+            negative = true
+            position++
+        }
+        val start = position
+        var value = 0L
+        while (position < end && bytes[position] in ZERO..NINE) {
+            value = value * 10 + (bytes[position] - ZERO)
+            if (value > Int.MAX_VALUE) throw malformed("integer overflow")
+            position++
+        }
+        if (position >= end) throw truncated("number may continue")
+        if (position == start) throw malformed("expected a number")
+        return (if (negative) -value else value).toInt()
+    }
+
+    /**
+     * Read an array of strings
+     */
+    fun readStringList(): List<String> {
+        if (peek() == LETTER_N) {
+            skipLiteral()
+            return emptyList()
+        }
+        beginArray()
+        if (!nextElement()) return emptyList()
+        val values = ArrayList<String>(2)
+        do {
+            values += readString()
+        } while (nextElement())
+        return values
+    }
+
+    /**
+     * Skip the next value of any type, including nested objects and arrays
+     */
+    fun skipValue() {
+        when (peek()) {
+            QUOTE -> readStringRange()
+            OPEN_BRACE -> {
+                beginObject()
+                while (nextEntry('}')) {
+                    readStringRange()
+                    consume(':')
+                    skipValue()
+                }
+            }
+            OPEN_BRACKET -> {
+                beginArray()
+                while (nextElement()) skipValue()
+            }
+            else -> skipLiteral()
+        }
+    }
+
+    /**
+     * The byte at the next non-whitespace position
+     */
+    fun peek(): Byte {
+        skipWhitespace()
+        if (position >= end) throw truncated("unexpected end of input")
+        return bytes[position]
+    }
+
+    private fun nextEntry(close: Char): Boolean {
+        val next = peek()
+        if (next == close.code.toByte()) {
+            position++
+            return false
+        }
+        if (next == COMMA) {
+            position++
+        } else if (position > 0 && !isContainerStart(bytes[lastNonWhitespace()])) {
+            throw malformed("expected ',' or '$close'")
+        }
+        return true
+    }
+
+    private fun isContainerStart(byte: Byte) = byte == OPEN_BRACE || byte == OPEN_BRACKET
+
+    private fun lastNonWhitespace(): Int {
+        var index = position - 1
+        while (index > 0 && isWhitespace(bytes[index])) index--
+        return index
+    }
+
+    private fun skipLiteral() {
+        skipWhitespace()
+        val start = position
+        while (position < end) {
+            val byte = bytes[position]
+            if (byte == COMMA || byte == CLOSE_BRACE || byte == CLOSE_BRACKET || isWhitespace(byte)) break
+            position++
+        }
+        if (position >= end) throw truncated("literal may continue")
+        if (position == start) throw malformed("expected a value")
+    }
+
+    private fun consume(expected: Char) {
+        if (peek() != expected.code.toByte()) throw malformed("expected '$expected'")
+        position++
+    }
+
+    private fun skipWhitespace() {
+        while (position < end && isWhitespace(bytes[position])) position++
+    }
+
+    private fun isWhitespace(byte: Byte) =
+        byte == SPACE || byte == NEWLINE || byte == CARRIAGE_RETURN || byte == TAB
+
+    private fun matches(key: ByteArray): Boolean {
+        for (i in key.indices) {
+            if (bytes[rangeStart + i] != key[i]) return false
+        }
+        return true
+    }
+
+    private fun unescape(from: Int, to: Int): String = buildString(to - from) {
+        var segmentStart = from
+        var index = from
+        while (index < to) {
+            if (bytes[index] != BACKSLASH) {
+                index++
+                continue
+            }
+            append(bytes.decodeToString(segmentStart, index))
+            val escaped = bytes[index + 1].toInt().toChar()
+            index += 2
+            when (escaped) {
+                'n' -> append('\n')
+                't' -> append('\t')
+                'r' -> append('\r')
+                'b' -> append('\b')
+                'f' -> append('\u000C')
+                'u' -> {
+                    if (index + 4 > to) throw malformed("truncated unicode escape")
+                    append(bytes.decodeToString(index, index + 4).toInt(16).toChar())
+                    index += 4
+                }
+                else -> append(escaped)
+            }
+            segmentStart = index
+        }
+        append(bytes.decodeToString(segmentStart, to))
+    }
+
+    private fun malformed(reason: String) = SerializationException("Malformed JSON at offset $position: $reason")
+
+    private fun truncated(reason: String) = TruncatedJsonException("Truncated JSON at offset $position: $reason")
+
+    companion object {
+        const val UNKNOWN_KEY = -1
+        const val END = -2
+
+        /**
+         * Build a key table for [nextKey]
+         */
+        fun keys(vararg names: String): Array<ByteArray> = Array(names.size) { names[it].encodeToByteArray() }
+
+        private const val QUOTE: Byte = 0x22
+        private const val BACKSLASH: Byte = 0x5C
+        private const val COMMA: Byte = 0x2C
+        private const val OPEN_BRACE: Byte = 0x7B
+        private const val CLOSE_BRACE: Byte = 0x7D
+        private const val OPEN_BRACKET: Byte = 0x5B
+        private const val CLOSE_BRACKET: Byte = 0x5D
+        private const val MINUS: Byte = 0x2D
+        private const val ZERO: Byte = 0x30
+        private const val NINE: Byte = 0x39
+        private const val LETTER_N: Byte = 0x6E
+        private const val SPACE: Byte = 0x20
+        private const val NEWLINE: Byte = 0x0A
+        private const val CARRIAGE_RETURN: Byte = 0x0D
+        private const val TAB: Byte = 0x09
+    }
+}
@@ -0,0 +1,110 @@
+package io.github.kotlin.allfunds.networking.data.remote.decode
+
+import io.github.kotlin.allfunds.networking.data.remote.UnexpectedStatusException
+import io.ktor.client.statement.HttpResponse
+import io.ktor.client.statement.bodyAsChannel
+import io.ktor.http.HttpHeaders
+import io.ktor.http.contentLength
+import io.ktor.http.isSuccess
+import io.ktor.utils.io.discard
+import io.ktor.utils.io.readAvailable
+import kotlinx.serialization.SerializationException
+import kotlin.time.Duration
+import kotlin.time.measureTimedValue
+
+/**
+ * Read the body of [response] into a pooled buffer and decode it
+ *
+ * The body is copied once, from the response channel into the buffer, and [decode] parses it in
+ * place; the buffer goes back to the pool when [decode] returns, so decoded values must not keep
+ * references to it. A compressed body is decompressed as it arrives, straight into the buffer.
+ *
+ * @param received Filled with the size and decompression time of the body when given
+ * @param decode Parser of the first `length` bytes of the buffer
+ * @throws IllegalStateException if the response status is not successful
+ */
+internal suspend fun <T> ByteBufferPool.decodeBody(
+    response: HttpResponse,
+    received: ReceivedBody? = null,
+    decode: suspend (bytes: ByteArray, length: Int) -> T
+): T = receive(response, received, partial = null, decode)
+
+/**
+ * Like [decodeBody], but retries [decode] as each chunk arrives and stops decoding once it
+ * succeeds
+ *
+ * The rest of the body is then read and discarded without being buffered or decompressed: an
+ * unread body closes the connection rather than returning it to the pool, and a new connection
+ * costs more than the remaining bytes of a response.
+ *
+ * @param decode Parser of the first `length` bytes of the buffer, or null if they are not enough
+ * @throws SerializationException if the body ends before [decode] succeeds
+ */
+internal suspend fun <T : Any> ByteBufferPool.decodeBodyPrefix(
+    response: HttpResponse,
+    decode: suspend (bytes: ByteArray, length: Int) -> T?
+): T = receive(response, received = null, decode) { bytes, length ->
+    decode(bytes, length) ?: throw SerializationException("Response body ended after $length bytes")
+}
+
+private suspend fun <T> ByteBufferPool.receive(
+    response: HttpResponse,
+    received: ReceivedBody?,
+    partial: (suspend (bytes: ByteArray, length: Int) -> T?)?,
+    complete: suspend (bytes: ByteArray, length: Int) -> T
+): T {
+    if (!response.status.isSuccess()) throw UnexpectedStatusException(response.status)
+    val channel = response.bodyAsChannel()
+    val decompressor = response.headers[HttpHeaders.ContentEncoding]?.let { decompressor(it) }
+    val contentLength = response.contentLength()?.takeIf { it in 1..Int.MAX_VALUE / COMPRESSION_RATIO }?.toInt()
+    val expected = contentLength?.let { if (decompressor != null) it * COMPRESSION_RATIO else it } ?: bufferSize
+    var buffer = acquire(expected)
+    val input = ByteArray(if (decompressor != null) COMPRESSED_CHUNK_SIZE else 0)
+    var wireBytes = 0
+    var decompression = Duration.ZERO
+    try {
+        var length = 0
+        while (true) {
+            if (length == buffer.size) buffer = grow(buffer)
+            val read = if (decompressor == null) {
+                channel.readAvailable(buffer, length, buffer.size - length).also { if (it > 0) wireBytes += it }
+            } else {
+                if (decompressor.finished) break
+                if (decompressor.needsInput()) {
+                    val chunk = channel.readAvailable(input, 0, input.size)
+                    if (chunk == -1) throw SerializationException("Compressed body ended after $wireBytes bytes")
+                    wireBytes += chunk
+                    decompressor.setInput(input, 0, chunk)
+                    continue
+                }
+                val (inflated, time) = measureTimedValue { decompressor.inflate(buffer, length, buffer.size - length) }
+                decompression += time
+                inflated
+            }
+            if (read == -1) break
+            length += read
+            if (partial != null && read > 0) {
+                partial(buffer, length)?.let { result ->
+                    channel.discard()
+                    return result
+                }
+            }
+        }
+        received?.let {
+            it.wireBytes = wireBytes
+            it.bytes = length
+            it.decompression = decompression
+        }
+        return complete(buffer, length)
+    } finally {
+        decompressor?.end()
+        release(buffer)
+    }
+}
+
+/**
+ * Assumed compression ratio of JSON, to size the buffer of a compressed body from its length
+ */
+private const val COMPRESSION_RATIO = 4
+
+private const val COMPRESSED_CHUNK_SIZE = 8 * 1024
@@ -0,0 +1,23 @@
+package io.github.kotlin.allfunds.networking.data.remote.decode
+
+import kotlin.time.Duration
+
+/**
+ * Size and decompression cost of a body received by [decodeBody]
+ */
+internal class ReceivedBody {
+    /**
+     * Bytes read from the connection, compressed if the server compressed the body
+     */
+    var wireBytes: Int = 0
+
+    /**
+     * Bytes of the body after decompression
+     */
+    var bytes: Int = 0
+
+    /**
+     * Time spent decompressing
+     */
+    var decompression: Duration = Duration.ZERO
+}
@@ -0,0 +1,88 @@
+package io.github.kotlin.allfunds.networking.data.remote.recording
+
+import kotlinx.io.buffered
+import kotlinx.io.files.Path
+import kotlinx.io.files.SystemFileSystem
+import kotlinx.io.readString
+import kotlinx.io.writeString
+import kotlinx.serialization.SerialName
+import kotlinx.serialization.Serializable
+import kotlinx.serialization.json.Json
+
+/**
+ * One recorded HTTP exchange
+ *
+ * @property method HTTP method of the request
+ * @property url Full request URL, including the query string
+ * @property requestHeaders Headers sent with the request
+ * @property status HTTP status code of the response
+ * @property responseHeaders Headers received with the response
+ * @property body Response body as text
+ * @property durationMicros Time from sending the request to receiving the full response
+ */
+@Serializable
+data class RecordedExchange(
+    @SerialName("m")
+    val method: String,
+
+    @SerialName("u")
+    val url: String,
+
+    @SerialName("qh")
+    val requestHeaders: Map<String, List<String>> = emptyMap(),
+
+    @SerialName("s")
+    val status: Int,
+
+    @SerialName("rh")
+    val responseHeaders: Map<String, List<String>> = emptyMap(),
+
+    @SerialName("b")
+    val body: String,
+
+    @SerialName("t")
+    val durationMicros: Long
+)
+
+/**
+ * Ordered collection of recorded exchanges
+ *
+ * Stored on disk as JSON lines, one exchange per line, so large recordings can be appended
+ * to and diffed easily.
+ */
+data class Cassette(val exchanges: List<RecordedExchange>) {
+
+    /**
+     * Encode the cassette as JSON lines
+     */
+    fun encode(): String = exchanges.joinToString(separator = "\n") {
+        json.encodeToString(RecordedExchange.serializer(), it)
+    }
+
+    /**
+     * Write the cassette to [path], replacing any existing file
+     */
+    fun save(path: Path) {
+        SystemFileSystem.sink(path).buffered().use { it.writeString(encode()) }
+    }
+
+    companion object {
+        private val json = Json { ignoreUnknownKeys = true }
+
+        /**
+         * Decode a cassette from JSON lines
+         */
+        fun decode(text: String): Cassette = Cassette(
+            text.lineSequence()
+                .filter { it.isNotBlank() }
+                .map { json.decodeFromString(RecordedExchange.serializer(), it) }
+                .toList()
+        )
+
+        /**
+         * Read a cassette previously written with [save]
+         */
+        fun load(path: Path): Cassette =
+            SystemFileSystem.source(path).buffered().use { decode(it.readString()) }
+    }
+}
@@ -0,0 +1,44 @@
+package io.github.kotlin.allfunds.networking.data.remote.recording
+
+import io.ktor.client.statement.HttpResponse
+import io.ktor.client.statement.bodyAsText
+import io.ktor.client.statement.request
+import io.ktor.util.toMap
+import kotlinx.coroutines.sync.Mutex
+import kotlinx.coroutines.sync.withLock
+import kotlin.time.Duration
+
+/**
+ * Captures the HTTP exchanges of a [io.github.kotlin.allfunds.networking.data.remote.ChuckNorrisApiImpl]
+ *
+ * Pass an instance in [io.github.kotlin.allfunds.networking.data.remote.ChuckNorrisApiConfig.recorder]
+ * to record every request, its headers, the response body and its timing.
+ */
+class ExchangeRecorder {
+    private val lock = Mutex()
+    private val exchanges = mutableListOf<RecordedExchange>()
+
+    /**
+     * Record one completed response
+     * @param response Response whose body has already been received
+     * @param duration Time from sending the request to receiving the response
+     */
+    suspend fun record(response: HttpResponse, duration: Duration) {
+        val request = response.request
+        val exchange = RecordedExchange(
+            method = request.method.value,
+            url = request.url.toString(),
+            requestHeaders = request.headers.toMap(),
+            status = response.status.value,
+            responseHeaders = response.headers.toMap(),
+            body = response.bodyAsText(),
+            durationMicros = duration.inWholeMicroseconds
+        )
+        lock.withLock { exchanges += exchange }
+    }
+
+    /**
+     * Snapshot of everything recorded so far
+     */
+    suspend fun cassette(): Cassette = lock.withLock { Cassette(exchanges.toList()) }
+}
@@ -0,0 +1,47 @@
+package io.github.kotlin.allfunds.networking.data.remote.routing
+
+import kotlin.time.Duration
+import kotlin.time.Duration.Companion.seconds
+
+/**
+ * Mirrors of the API and how calls are spread over them
+ *
+ * Every endpoint, the base URL first, is scored by an exponentially weighted moving average of
+ * its latency, scaled by its calls in flight, plus its recent error rate times [errorPenalty].
+ * Calls go to the best scored endpoint, and a call that fails on one endpoint is retried on the
+ * next best until every endpoint has been tried. An endpoint failing [ejectAfterFailures] calls
+ * in a row is left out for [ejectionTime], then given one call to prove itself again.
+ *
+ * @property mirrors Base URLs serving the same API as the configured base URL
+ * @property strategy How the endpoint of a call is picked
+ * @property smoothing Weight of each new latency or error sample in the averages
+ * @property errorPenalty Latency an endpoint that always fails is ranked as slower by
+ * @property ejectAfterFailures Consecutive failures that eject an endpoint
+ * @property ejectionTime How long an ejected endpoint is left out
+ */
+data class EndpointRouting(
+    val mirrors: List<String> = emptyList(),
+    val strategy: Strategy = Strategy.LOWEST_LATENCY,
+    val smoothing: Double = 0.3,
+    val errorPenalty: Duration = 1.seconds,
+    val ejectAfterFailures: Int = 3,
+    val ejectionTime: Duration = 30.seconds
+) {
+    init {
+        require(smoothing > 0.0 && smoothing <= 1.0) { "smoothing must be between 0 and 1" }
+        require(ejectAfterFailures > 0) { "ejectAfterFailures must be positive" }
+    }
+
+    enum class Strategy {
+        /**
+         * Always the best scored endpoint
+         */
+        LOWEST_LATENCY,
+
+        /**
+         * The better of two endpoints picked at random, which spreads load from many clients
+         * instead of piling it on the single best mirror
+         */
+        POWER_OF_TWO_CHOICES
+    }
+}
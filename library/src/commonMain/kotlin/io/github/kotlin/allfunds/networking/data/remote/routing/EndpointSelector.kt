@@ -0,0 +1,119 @@
+package io.github.kotlin.allfunds.networking.data.remote.routing
+
+import io.ktor.http.Url
+import io.ktor.http.hostWithPort
+import kotlinx.coroutines.sync.Mutex
+import kotlinx.coroutines.sync.withLock
+import kotlin.random.Random
+import kotlin.time.Duration
+import kotlin.time.Duration.Companion.nanoseconds
+import kotlin.time.TimeMark
+import kotlin.time.TimeSource
+
+/**
+ * One base URL of the API with its score; the mutable state is guarded by [EndpointSelector]
+ */
+internal class Endpoint(val baseUrl: String) {
+    val host: String = Url(baseUrl).hostWithPort
+
+    var latencyNanos = -1.0
+    var errorRate = 0.0
+    var consecutiveFailures = 0
+    var inFlight = 0
+    var ejectedUntil: TimeMark? = null
+}
+
+/**
+ * Picks the endpoint of each call and keeps the endpoint scores, see [EndpointRouting]
+ *
+ * @param baseUrls Endpoints in order of preference, used to break ties
+ */
+internal class EndpointSelector(
+    baseUrls: List<String>,
+    private val routing: EndpointRouting,
+    private val timeSource: TimeSource = TimeSource.Monotonic,
+    private val random: Random = Random
+) {
+    val endpoints: List<Endpoint> = baseUrls.distinct().map { Endpoint(it) }
+
+    private val mutex = Mutex()
+
+    /**
+     * Pick the endpoint for the next attempt of a call and count it as in flight
+     * @param tried Endpoints the call already failed on
+     * @return The endpoint, or null when every endpoint has been tried
+     */
+    suspend fun select(tried: Set<Endpoint>): Endpoint? = mutex.withLock {
+        val untried = endpoints.filter { it !in tried }
+        if (untried.isEmpty()) return null
+        val available = untried.filter { !isEjected(it) }
+        // With every remaining endpoint ejected, the one due back first is the best bet
+        val chosen = if (available.isEmpty()) {
+            untried.minBy { it.ejectedUntil?.elapsedNow()?.unaryMinus() ?: Duration.ZERO }
+        } else if (routing.strategy == EndpointRouting.Strategy.POWER_OF_TWO_CHOICES && available.size > 1) {
+            val first = random.nextInt(available.size)
+            val second = (first + 1 + random.nextInt(available.size - 1)) % available.size
+            listOf(available[first], available[second]).minBy { cost(it) }
+        } else {
+            available.minBy { cost(it) }
+        }
+        chosen.inFlight++
+        chosen
+    }
+
+    /**
+     * Record the outcome of an attempt started with [select]
+     * @param latency Duration of a successful attempt, or null when it failed or was cancelled
+     * @param failed Whether the endpoint failed the attempt
+     */
+    suspend fun record(endpoint: Endpoint, latency: Duration?, failed: Boolean) = mutex.withLock {
+        endpoint.inFlight--
+        val smoothing = routing.smoothing
+        if (failed) {
+            endpoint.errorRate += smoothing * (1.0 - endpoint.errorRate)
+            endpoint.consecutiveFailures++
+            if (endpoint.consecutiveFailures >= routing.ejectAfterFailures) {
+                endpoint.ejectedUntil = timeSource.markNow() + routing.ejectionTime
+            }
+        } else if (latency != null) {
+            val nanos = latency.inWholeNanoseconds.toDouble()
+            endpoint.latencyNanos = if (endpoint.latencyNanos < 0) nanos else endpoint.latencyNanos + smoothing * (nanos - endpoint.latencyNanos)
+            endpoint.errorRate -= smoothing * endpoint.errorRate
+            endpoint.consecutiveFailures = 0
+            endpoint.ejectedUntil = null
+        }
+    }
+
+    /**
+     * Current scores of all endpoints
+     */
+    suspend fun status(): List<EndpointStatus> = mutex.withLock {
+        endpoints.map {
+            EndpointStatus(
+                baseUrl = it.baseUrl,
+                latency = it.latencyNanos.takeIf { nanos -> nanos >= 0 }?.nanoseconds,
+                errorRate = it.errorRate,
+                inFlight = it.inFlight,
+                ejected = it.ejectedUntil?.hasNotPassedNow() == true
+            )
+        }
+    }
+
+    private fun isEjected(endpoint: Endpoint): Boolean {
+        val until = endpoint.ejectedUntil ?: return false
+        if (until.hasNotPassedNow()) return true
+        // Back on probation: one more failure ejects it again
+        endpoint.ejectedUntil = null
+        endpoint.consecutiveFailures = routing.ejectAfterFailures - 1
+        return false
+    }
+
+    /**
+     * Expected cost of a call on [endpoint]; endpoints without a latency sample cost nothing,
+     * so every endpoint is measured at least once
+     */
+    private fun cost(endpoint: Endpoint): Double {
+        val latency = endpoint.latencyNanos.coerceAtLeast(0.0)
+        return latency * (endpoint.inFlight + 1) + endpoint.errorRate * routing.errorPenalty.inWholeNanoseconds
+    }
+}
@@ -0,0 +1,20 @@
+package io.github.kotlin.allfunds.networking.data.remote.routing
+
+import kotlin.time.Duration
+
+/**
+ * Current score of one API endpoint
+ *
+ * @property baseUrl Base URL of the endpoint
+ * @property latency Average latency of its successful calls, or null before the first one
+ * @property errorRate Average share of its calls that failed, from 0 to 1
+ * @property inFlight Calls running on it now
+ * @property ejected Whether it is left out after repeated failures
+ */
+data class EndpointStatus(
+    val baseUrl: String,
+    val latency: Duration?,
+    val errorRate: Double,
+    val inFlight: Int,
+    val ejected: Boolean
+)
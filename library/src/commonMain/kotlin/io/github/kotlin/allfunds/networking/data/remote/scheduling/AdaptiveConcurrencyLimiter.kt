@@ -0,0 +1,192 @@
+package io.github.kotlin.allfunds.networking.data.remote.scheduling
+
+import io.github.kotlin.allfunds.networking.data.remote.RequestRejectedException
+import io.github.kotlin.allfunds.networking.data.remote.isOverload
+import kotlinx.coroutines.CancellationException
+import kotlinx.coroutines.CompletableDeferred
+import kotlinx.coroutines.NonCancellable
+import kotlinx.coroutines.sync.Mutex
+import kotlinx.coroutines.sync.withLock
+import kotlinx.coroutines.withContext
+import kotlinx.coroutines.withTimeoutOrNull
+import kotlin.math.sqrt
+import kotlin.time.Duration
+import kotlin.time.Duration.Companion.seconds
+import kotlin.time.TimeSource
+
+/**
+ * Limits the calls in flight to an estimate of what the API can serve without queuing
+ *
+ * The limit follows the gradient between the lowest round-trip time seen and the current one:
+ * while calls return about as fast as the lowest RTT the limit grows by roughly its square root,
+ * and as the RTT rises above [rttTolerance] times the lowest one, it shrinks in proportion.
+ * A call failing with an overload error cuts the limit by [backoffRatio], the AIMD fallback for
+ * overload that shows up as errors rather than latency; other errors, such as a 404 for an unknown
+ * category, are sampled like answers. The lowest RTT is re-measured every [probeInterval] calls, so the
+ * limit can recover after the API gets slower for good.
+ *
+ * Calls over the limit wait in a queue of at most [maxQueued] calls for up to [maxWait]. A call
+ * that finds the queue full, or waits too long, fails with [RequestRejectedException].
+ *
+ * @param initialLimit Limit before any call has completed
+ * @param minLimit Lowest the limit can go
+ * @param maxLimit Highest the limit can go
+ * @param maxQueued Calls that may wait for a slot
+ * @param maxWait Longest a call waits for a slot
+ * @param rttTolerance RTT increase over the lowest RTT that is not treated as queuing
+ * @param backoffRatio Factor the limit is multiplied by when a call fails
+ * @param smoothing Weight of each new estimate in the limit
+ * @param probeInterval Calls between resets of the lowest RTT
+ * @param timeSource Clock for the round-trip times
+ * @param overload Whether an error of a call says the API is overloaded: by default server
+ * errors, 408, 429, timeouts and connection failures
+ */
+class AdaptiveConcurrencyLimiter(
+    initialLimit: Int = 10,
+    val minLimit: Int = 1,
+    val maxLimit: Int = 200,
+    val maxQueued: Int = 50,
+    val maxWait: Duration = 1.seconds,
+    private val rttTolerance: Double = 2.0,
+    private val backoffRatio: Double = 0.9,
+    private val smoothing: Double = 0.2,
+    private val probeInterval: Int = 500,
+    private val timeSource: TimeSource = TimeSource.Monotonic,
+    private val overload: (Throwable) -> Boolean = ::isOverload
+) {
+    init {
+        require(minLimit in 1..maxLimit) { "minLimit must be between 1 and maxLimit" }
+        require(initialLimit in minLimit..maxLimit) { "initialLimit must be between minLimit and maxLimit" }
+        require(maxQueued >= 0) { "maxQueued must not be negative" }
+        require(rttTolerance >= 1.0) { "rttTolerance must be at least 1" }
+        require(backoffRatio > 0.0 && backoffRatio < 1.0) { "backoffRatio must be between 0 and 1" }
+        require(smoothing > 0.0 && smoothing <= 1.0) { "smoothing must be between 0 and 1" }
+        require(probeInterval > 0) { "probeInterval must be positive" }
+    }
+
+    private val mutex = Mutex()
+    private val waiters = ArrayDeque<CompletableDeferred<Unit>>()
+    private var estimate = initialLimit.toDouble()
+    private var inFlight = 0
+    private var lowestRtt: Duration? = null
+    private var samples = 0
+    private var rejections = 0
+
+    /**
+     * Current limit on calls in flight
+     */
+    suspend fun limit(): Int = mutex.withLock { estimate.toInt() }
+
+    /**
+     * Calls running now
+     */
+    suspend fun inFlight(): Int = mutex.withLock { inFlight }
+
+    /**
+     * Calls waiting for a slot now
+     */
+    suspend fun queued(): Int = mutex.withLock { waiters.size }
+
+    /**
+     * Calls rejected so far
+     */
+    suspend fun rejections(): Int = mutex.withLock { rejections }
+
+    /**
+     * Run [block] once it fits the limit, and feed its round-trip time into the limit
+     * @throws RequestRejectedException if the queue is full or the wait exceeds [maxWait]
+     */
+    suspend fun <T> run(block: suspend () -> T): T {
+        val started = acquire()
+        val mark = timeSource.markNow()
+        try {
+            val result = block()
+            complete(mark.elapsedNow(), started, failed = false)
+            return result
+        } catch (e: CancellationException) {
+            complete(null, started, failed = false)
+            throw e
+        } catch (e: Throwable) {
+            if (overload(e)) complete(null, started, failed = true) else complete(mark.elapsedNow(), started, failed = false)
+            throw e
+        }
+    }
+
+    /**
+     * Take a slot, waiting in the queue if needed
+     * @return Calls in flight once this one started
+     */
+    private suspend fun acquire(): Int {
+        val waiter = mutex.withLock {
+            if (inFlight < estimate.toInt()) return ++inFlight
+            if (waiters.size >= maxQueued) {
+                rejections++
+                throw RequestRejectedException(
+                    "Concurrency limit of ${estimate.toInt()} reached and queue full",
+                    RequestRejectedException.Reason.QUEUE_FULL
+                )
+            }
+            CompletableDeferred<Unit>().also { waiters.addLast(it) }
+        }
+        val granted = try {
+            withTimeoutOrNull(maxWait) { waiter.await() } != null
+        } catch (e: CancellationException) {
+            withContext(NonCancellable) { abandon(waiter, rejected = false) }
+            throw e
+        }
+        if (!granted) {
+            withContext(NonCancellable) { abandon(waiter, rejected = true) }
+            throw RequestRejectedException("No concurrency slot within $maxWait", RequestRejectedException.Reason.QUEUE_TIMEOUT)
+        }
+        return mutex.withLock { inFlight }
+    }
+
+    /**
+     * Leave the queue, handing back the slot if it was granted while leaving
+     */
+    private suspend fun abandon(waiter: CompletableDeferred<Unit>, rejected: Boolean) = mutex.withLock {
+        if (rejected) rejections++
+        if (!waiters.remove(waiter)) {
+            inFlight--
+            dispatch()
+        }
+    }
+
+    private suspend fun complete(rtt: Duration?, inFlightAtStart: Int, failed: Boolean) {
+        withContext(NonCancellable) {
+            mutex.withLock {
+                inFlight--
+                if (failed) {
+                    estimate = (estimate * backoffRatio).coerceAtLeast(minLimit.toDouble())
+                } else if (rtt != null) {
+                    sample(rtt, inFlightAtStart)
+                }
+                dispatch()
+            }
+        }
+    }
+
+    private fun sample(rtt: Duration, inFlightAtStart: Int) {
+        samples++
+        val previous = lowestRtt
+        val lowest = if (previous == null || rtt < previous || samples % probeInterval == 0) rtt else previous
+        lowestRtt = lowest
+        // A call that did not use half the limit says nothing about whether a higher one would fit
+        if (inFlightAtStart * 2 < estimate) return
+        val gradient = if (rtt.isPositive()) {
+            (rttTolerance * lowest.inWholeNanoseconds / rtt.inWholeNanoseconds).coerceIn(0.5, 1.0)
+        } else {
+            1.0
+        }
+        val target = estimate * gradient + sqrt(estimate)
+        estimate = (estimate * (1 - smoothing) + target * smoothing).coerceIn(minLimit.toDouble(), maxLimit.toDouble())
+    }
+
+    private fun dispatch() {
+        while (inFlight < estimate.toInt()) {
+            val next = waiters.removeFirstOrNull() ?: return
+            inFlight++
+            next.complete(Unit)
+        }
+    }
+}
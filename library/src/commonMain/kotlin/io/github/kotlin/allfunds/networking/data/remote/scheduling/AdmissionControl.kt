@@ -0,0 +1,45 @@
+package io.github.kotlin.allfunds.networking.data.remote.scheduling
+
+import io.github.kotlin.allfunds.networking.data.remote.RequestRejectedException
+import kotlin.time.Duration
+import kotlin.time.Duration.Companion.milliseconds
+import kotlin.time.Duration.Companion.seconds
+
+/**
+ * Bounds the calls waiting for each API endpoint, so overload is shed instead of queued
+ *
+ * Each endpoint runs at most [maxInFlight] calls; further calls wait in a first-in first-out
+ * queue. A call that finds [maxQueued] calls already waiting is rejected at once, and a call
+ * that waits longer than [maxQueueTime] gives up. Both fail with [RequestRejectedException]
+ * without reaching the API.
+ *
+ * With [codel], the queue also sheds load the way CoDel does: once it has not been empty for
+ * [codelInterval], it is backed up rather than absorbing a burst, and calls that have waited
+ * longer than [codelTarget] are dropped when their turn comes, so the calls that do run are
+ * recent ones whose callers are still waiting for them.
+ *
+ * @property maxInFlight Calls running at once on one endpoint
+ * @property maxQueued Calls that may wait for one endpoint
+ * @property maxQueueTime Longest a call waits for a slot
+ * @property codel Drop calls that waited past [codelTarget] while the queue stays backed up
+ * @property codelTarget Queue time a backed up queue still accepts
+ * @property codelInterval Time the queue must stay non-empty to count as backed up
+ */
+data class AdmissionControl(
+    val maxInFlight: Int = 8,
+    val maxQueued: Int = 32,
+    val maxQueueTime: Duration = 2.seconds,
+    val codel: Boolean = true,
+    val codelTarget: Duration = 100.milliseconds,
+    val codelInterval: Duration = 500.milliseconds
+) {
+    init {
+        require(maxInFlight > 0) { "maxInFlight must be positive" }
+        require(maxQueued >= 0) { "maxQueued must not be negative" }
+        require(maxQueueTime.isPositive()) { "maxQueueTime must be positive" }
+        require(codelTarget.isPositive() && codelTarget <= maxQueueTime) {
+            "codelTarget must be positive and at most maxQueueTime"
+        }
+        require(codelInterval.isPositive()) { "codelInterval must be positive" }
+    }
+}
@@ -0,0 +1,136 @@
+package io.github.kotlin.allfunds.networking.data.remote.scheduling
+
+import io.github.kotlin.allfunds.networking.data.remote.RequestRejectedException
+import kotlinx.coroutines.CancellationException
+import kotlinx.coroutines.CompletableDeferred
+import kotlinx.coroutines.ExperimentalCoroutinesApi
+import kotlinx.coroutines.NonCancellable
+import kotlinx.coroutines.sync.Mutex
+import kotlinx.coroutines.sync.withLock
+import kotlinx.coroutines.withContext
+import kotlinx.coroutines.withTimeoutOrNull
+import kotlin.time.TimeMark
+import kotlin.time.TimeSource
+
+/**
+ * The bounded queue of one API endpoint, see [AdmissionControl]
+ */
+internal class AdmissionQueue(
+    private val baseUrl: String,
+    private val control: AdmissionControl,
+    private val timeSource: TimeSource = TimeSource.Monotonic
+) {
+    /**
+     * A call waiting for a slot; completed with true when it may run, false when it is dropped
+     */
+    private class Waiter(val queuedAt: TimeMark) {
+        val admitted = CompletableDeferred<Boolean>()
+    }
+
+    private val mutex = Mutex()
+    private val waiters = ArrayDeque<Waiter>()
+    private var inFlight = 0
+    private var lastEmpty = timeSource.markNow()
+    private var rejected = 0L
+    private var timedOut = 0L
+    private var dropped = 0L
+
+    suspend fun stats(): AdmissionStats = mutex.withLock {
+        AdmissionStats(baseUrl, inFlight, waiters.size, rejected, timedOut, dropped)
+    }
+
+    /**
+     * Run [block] once a slot of the endpoint is free
+     * @throws RequestRejectedException if the queue is full, the wait is too long, or the call is dropped
+     */
+    suspend fun <T> run(block: suspend () -> T): T {
+        acquire()
+        try {
+            return block()
+        } finally {
+            withContext(NonCancellable) { release() }
+        }
+    }
+
+    private suspend fun acquire() {
+        val waiter = mutex.withLock {
+            if (waiters.isEmpty()) {
+                lastEmpty = timeSource.markNow()
+                if (inFlight < control.maxInFlight) {
+                    inFlight++
+                    return
+                }
+            }
+            if (waiters.size >= control.maxQueued) {
+                rejected++
+                throw RequestRejectedException(
+                    "$baseUrl has ${control.maxQueued} calls waiting",
+                    RequestRejectedException.Reason.QUEUE_FULL
+                )
+            }
+            Waiter(timeSource.markNow()).also { waiters.addLast(it) }
+        }
+        val admitted = try {
+            withTimeoutOrNull(control.maxQueueTime) { waiter.admitted.await() }
+        } catch (e: CancellationException) {
+            withContext(NonCancellable) {
+                // Admitted just before the cancellation, so give the slot back
+                if (abandon(waiter, timedOut = false)) release()
+            }
+            throw e
+        }
+        when (admitted) {
+            true -> return
+            false -> throw RequestRejectedException(
+                "$baseUrl is backed up, dropped after waiting ${waiter.queuedAt.elapsedNow()}",
+                RequestRejectedException.Reason.DROPPED
+            )
+            null -> {
+                // Admitted just as the wait ran out, so the call keeps its slot
+                if (withContext(NonCancellable) { abandon(waiter, timedOut = true) }) return
+                throw RequestRejectedException(
+                    "No slot on $baseUrl within ${control.maxQueueTime}",
+                    RequestRejectedException.Reason.QUEUE_TIMEOUT
+                )
+            }
+        }
+    }
+
+    /**
+     * Leave the queue after a timeout or a cancellation
+     * @return Whether the call was admitted before it could leave, so it holds a slot
+     */
+    @OptIn(ExperimentalCoroutinesApi::class)
+    private suspend fun abandon(waiter: Waiter, timedOut: Boolean): Boolean = mutex.withLock {
+        if (waiters.remove(waiter)) {
+            if (timedOut) this.timedOut++
+            false
+        } else {
+            waiter.admitted.getCompleted()
+        }
+    }
+
+    private suspend fun release() = mutex.withLock {
+        inFlight--
+        dispatch()
+    }
+
+    /**
+     * Admit waiting calls while slots are free, dropping the stale ones of a backed up queue
+     */
+    private fun dispatch() {
+        while (inFlight < control.maxInFlight) {
+            val next = waiters.removeFirstOrNull() ?: break
+            if (control.codel && isBackedUp() && next.queuedAt.elapsedNow() > control.codelTarget) {
+                dropped++
+                next.admitted.complete(false)
+                continue
+            }
+            inFlight++
+            next.admitted.complete(true)
+        }
+        if (waiters.isEmpty()) lastEmpty = timeSource.markNow()
+    }
+
+    private fun isBackedUp(): Boolean = lastEmpty.elapsedNow() >= control.codelInterval
+}
@@ -0,0 +1,20 @@
+package io.github.kotlin.allfunds.networking.data.remote.scheduling
+
+/**
+ * Admission counters of one API endpoint, see [AdmissionControl]
+ *
+ * @property baseUrl Base URL of the endpoint
+ * @property inFlight Calls running on it now
+ * @property queued Calls waiting for it now
+ * @property rejected Calls refused because the queue was full
+ * @property timedOut Calls that gave up after the longest queue time
+ * @property dropped Calls shed from the backed up queue
+ */
+data class AdmissionStats(
+    val baseUrl: String,
+    val inFlight: Int,
+    val queued: Int,
+    val rejected: Long,
+    val timedOut: Long,
+    val dropped: Long
+)
@@ -0,0 +1,21 @@
+package io.github.kotlin.allfunds.networking.data.remote.scheduling
+
+/**
+ * Priority class of an API request, highest first
+ */
+enum class RequestPriority {
+    /**
+     * A user is waiting for the result
+     */
+    INTERACTIVE,
+
+    /**
+     * Default for requests without a priority
+     */
+    NORMAL,
+
+    /**
+     * Prefetching and bulk work, which runs only when it does not delay the other classes
+     */
+    BACKGROUND
+}
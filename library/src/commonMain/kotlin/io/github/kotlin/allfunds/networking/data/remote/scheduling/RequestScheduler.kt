@@ -0,0 +1,148 @@
+package io.github.kotlin.allfunds.networking.data.remote.scheduling
+
+import kotlinx.coroutines.CancellationException
+import kotlinx.coroutines.CompletableDeferred
+import kotlinx.coroutines.NonCancellable
+import kotlinx.coroutines.sync.Mutex
+import kotlinx.coroutines.sync.withLock
+import kotlinx.coroutines.withContext
+
+/**
+ * Orders API requests by priority and limits how many run at once, overall and per host
+ *
+ * Waiting requests start in [RequestPriority] order. Within a priority class, callers share the
+ * slots by weighted fair queuing over their [RequestScheduling.tag]: a tag with weight 2 starts
+ * twice as many requests as a tag with weight 1 while both are waiting. Background requests never
+ * take the last [reservedSlots] slots of a host or of the scheduler, so an interactive request
+ * only waits for background work when the reserve is taken by other interactive requests.
+ *
+ * One scheduler can be shared by several APIs to apply its limits across them.
+ *
+ * @param maxInFlight Requests running at once over all hosts
+ * @param maxInFlightPerHost Requests running at once to one host
+ * @param reservedSlots Slots per host and overall that background requests leave free
+ * @param tagWeights Share of each tag within its priority class; tags not listed have weight 1
+ */
+class RequestScheduler(
+    val maxInFlight: Int = 64,
+    val maxInFlightPerHost: Int = 5,
+    val reservedSlots: Int = 1,
+    private val tagWeights: Map<String, Int> = emptyMap()
+) {
+    init {
+        require(maxInFlight > 0) { "maxInFlight must be positive" }
+        require(maxInFlightPerHost > 0) { "maxInFlightPerHost must be positive" }
+        require(reservedSlots in 0 until minOf(maxInFlight, maxInFlightPerHost)) {
+            "reservedSlots must be below maxInFlight and maxInFlightPerHost"
+        }
+        require(tagWeights.values.all { it > 0 }) { "tag weights must be positive" }
+    }
+
+    /**
+     * A request waiting for a slot
+     * @property start Virtual time the request was queued at, for its tag
+     * @property finish Virtual time the request is due, the order within its priority class
+     */
+    private class Waiter(
+        val host: String,
+        val priority: RequestPriority,
+        val start: Double,
+        val finish: Double,
+        val sequence: Long
+    ) {
+        val granted = CompletableDeferred<Unit>()
+    }
+
+    private val mutex = Mutex()
+    private val queues = Array(RequestPriority.entries.size) { ArrayList<Waiter>() }
+    private val hostInFlight = HashMap<String, Int>()
+    private val lastFinish = HashMap<String, Double>()
+    private var inFlight = 0
+    private var virtualTime = 0.0
+    private var sequence = 0L
+
+    /**
+     * Requests running now
+     */
+    suspend fun inFlight(): Int = mutex.withLock { inFlight }
+
+    /**
+     * Requests waiting for a slot now
+     */
+    suspend fun queued(): Int = mutex.withLock { queues.sumOf { it.size } }
+
+    /**
+     * Run [block] once a slot to [host] is free for [scheduling]
+     * @param host Host the request goes to
+     * @param scheduling Priority class and tag of the request
+     */
+    suspend fun <T> run(host: String, scheduling: RequestScheduling, block: suspend () -> T): T {
+        acquire(host, scheduling)
+        try {
+            return block()
+        } finally {
+            withContext(NonCancellable) {
+                mutex.withLock {
+                    release(host)
+                    dispatch()
+                }
+            }
+        }
+    }
+
+    private suspend fun acquire(host: String, scheduling: RequestScheduling) {
+        val waiter = mutex.withLock {
+            val weight = tagWeights[scheduling.tag] ?: 1
+            val start = maxOf(virtualTime, lastFinish[scheduling.tag] ?: 0.0)
+            val finish = start + 1.0 / weight
+            lastFinish[scheduling.tag] = finish
+            Waiter(host, scheduling.priority, start, finish, sequence++).also {
+                queues[scheduling.priority.ordinal] += it
+                dispatch()
+            }
+        }
+        try {
+            waiter.granted.await()
+        } catch (e: CancellationException) {
+            withContext(NonCancellable) {
+                mutex.withLock {
+                    // Granted just before the cancellation, so give the slot back
+                    if (!queues[waiter.priority.ordinal].remove(waiter)) release(host)
+                    dispatch()
+                }
+            }
+            throw e
+        }
+    }
+
+    /**
+     * Start every waiting request that fits the limits, highest priority and earliest finish first
+     */
+    private fun dispatch() {
+        for (queue in queues) {
+            while (true) {
+                val next = queue.filter { canStart(it) }
+                    .minWithOrNull(compareBy<Waiter> { it.finish }.thenBy { it.sequence })
+                    ?: break
+                queue.remove(next)
+                inFlight++
+                hostInFlight[next.host] = (hostInFlight[next.host] ?: 0) + 1
+                virtualTime = maxOf(virtualTime, next.start)
+                next.granted.complete(Unit)
+            }
+        }
+        if (queues.all { it.isEmpty() }) lastFinish.clear()
+    }
+
+    private fun canStart(waiter: Waiter): Boolean {
+        val reserve = if (waiter.priority == RequestPriority.BACKGROUND) reservedSlots else 0
+        return inFlight < maxInFlight - reserve &&
+            (hostInFlight[waiter.host] ?: 0) < maxInFlightPerHost - reserve
+    }
+
+    private fun release(host: String) {
+        inFlight--
+        val remaining = (hostInFlight[host] ?: 1) - 1
+        if (remaining == 0) hostInFlight.remove(host) else hostInFlight[host] = remaining
+    }
+}
@@ -0,0 +1,36 @@
+package io.github.kotlin.allfunds.networking.data.remote.scheduling
+
+import kotlin.coroutines.AbstractCoroutineContextElement
+import kotlin.coroutines.CoroutineContext
+
+/**
+ * Coroutine context element giving the API calls made inside it a priority and a caller tag
+ *
+ * ```
+ * withContext(RequestScheduling(RequestPriority.BACKGROUND, tag = "prefetch")) {
+ *     client.searchJokes("kick")
+ * }
+ * ```
+ *
+ * @property priority Priority class of the calls
+ * @property tag Caller the calls are accounted to, for fair sharing within a priority class
+ */
+class RequestScheduling(
+    val priority: RequestPriority,
+    val tag: String = DEFAULT_TAG
+) : AbstractCoroutineContextElement(Key) {
+
+    override fun toString(): String = "RequestScheduling($priority, $tag)"
+
+    companion object Key : CoroutineContext.Key<RequestScheduling> {
+        /**
+         * Tag of calls made without one
+         */
+        const val DEFAULT_TAG = "default"
+
+        /**
+         * Scheduling of calls made outside any [RequestScheduling]
+         */
+        val DEFAULT = RequestScheduling(RequestPriority.NORMAL)
+    }
+}
@@ -0,0 +1,88 @@
+package io.github.kotlin.allfunds.networking.data.remote.slo
+
+import io.github.kotlin.allfunds.networking.data.remote.dto.JokeDto
+import io.github.kotlin.allfunds.networking.data.remote.dto.SearchResponseDto
+import io.github.kotlin.allfunds.networking.domain.model.JokeSearchResult
+import io.github.kotlin.allfunds.networking.domain.model.SearchProjection
+import kotlinx.coroutines.sync.Mutex
+import kotlinx.coroutines.sync.withLock
+import kotlin.random.Random
+
+/**
+ * The last answers of the API, kept to answer degraded operations, see [SloController]
+ *
+ * Holds the last categories, the last [searchCapacity] searches, least recently used first out,
+ * and the last [randomCapacity] random jokes.
+ */
+internal class FallbackStore(
+    private val randomCapacity: Int = 64,
+    private val searchCapacity: Int = 32,
+    private val random: Random = Random
+) {
+    private class Search(var response: SearchResponseDto?, var result: JokeSearchResult?, var projection: SearchProjection?)
+
+    private val mutex = Mutex()
+    private var categories: List<String>? = null
+    private val jokes = ArrayDeque<JokeDto>()
+    private val searches = LinkedHashMap<String, Search>()
+
+    suspend fun keepCategories(categories: List<String>) = mutex.withLock { this.categories = categories }
+
+    suspend fun categories(): List<String>? = mutex.withLock { categories }
+
+    suspend fun keepJoke(joke: JokeDto) = mutex.withLock {
+        jokes.removeAll { it.id == joke.id }
+        jokes.addLast(joke)
+        if (jokes.size > randomCapacity) jokes.removeFirst()
+    }
+
+    /**
+     * A kept joke picked at random, from [category] when given
+     */
+    suspend fun randomJoke(category: String? = null): JokeDto? = mutex.withLock {
+        val candidates = if (category == null) jokes else jokes.filter { category in it.categories }
+        candidates.randomOrNull(random)
+    }
+
+    suspend fun keepSearch(query: String, response: SearchResponseDto) = mutex.withLock {
+        search(query).response = response
+    }
+
+    suspend fun keepSearch(query: String, result: JokeSearchResult, projection: SearchProjection) = mutex.withLock {
+        val search = search(query)
+        // A narrower projection does not replace jokes holding more fields
+        if ((search.projection?.ordinal ?: -1) <= projection.ordinal) {
+            search.result = result
+            search.projection = projection
+        }
+    }
+
+    suspend fun searchResponse(query: String): SearchResponseDto? = mutex.withLock { touch(query)?.response }
+
+    /**
+     * A kept search of [query] holding at least the fields of [projection]
+     */
+    suspend fun searchResult(query: String, projection: SearchProjection): JokeSearchResult? {
+        val (kept, response) = mutex.withLock {
+            val search = touch(query) ?: return null
+            val covers = (search.projection?.ordinal ?: -1) >= projection.ordinal
+            (if (covers) search.result else null) to search.response
+        }
+        // Mapping a kept response runs outside the lock
+        val result = kept ?: response?.let { JokeSearchResult(it.total, it.toDomain()) } ?: return null
+        return if (projection == SearchProjection.COUNT_ONLY) result.copy(jokes = emptyList()) else result
+    }
+
+    private fun search(query: String): Search {
+        val search = searches.remove(query) ?: Search(null, null, null)
+        searches[query] = search
+        if (searches.size > searchCapacity) searches.remove(searches.keys.first())
+        return search
+    }
+
+    private fun touch(query: String): Search? {
+        val search = searches.remove(query) ?: return null
+        searches[query] = search
+        return search
+    }
+}
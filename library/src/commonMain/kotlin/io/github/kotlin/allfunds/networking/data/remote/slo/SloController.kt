@@ -0,0 +1,206 @@
+package io.github.kotlin.allfunds.networking.data.remote.slo
+
+import kotlinx.coroutines.CancellationException
+import kotlinx.coroutines.sync.Mutex
+import kotlinx.coroutines.sync.withLock
+import kotlin.math.ceil
+import kotlin.time.Duration
+import kotlin.time.Duration.Companion.nanoseconds
+import kotlin.time.Duration.Companion.seconds
+import kotlin.time.TimeMark
+import kotlin.time.TimeSource
+
+/**
+ * Watches the latency and error rate of each API operation and degrades an operation to local
+ * data when it breaks its budget
+ *
+ * Every answered or failed call is sampled for its operation over a rolling [window]. Once the window holds
+ * [minSamples] calls, an operation whose [percentile] latency exceeds [latencyBudget], or whose
+ * error rate exceeds [maxErrorRate], turns [SloMode.DEGRADED]: its calls are answered at once
+ * from the last categories, searches and random jokes the API returned, and one call every
+ * [probeInterval] still goes upstream as a probe. After [recoveryProbes] probes in a row succeed
+ * within the budget, the operation turns [SloMode.HEALTHY] again with a fresh window. Calls that
+ * have no local answer go upstream in either mode.
+ *
+ * One controller can be shared by several APIs; their calls are sampled together.
+ *
+ * @param latencyBudget Highest acceptable [percentile] latency
+ * @param percentile Latency percentile held to the budget, from 0 to 1
+ * @param maxErrorRate Highest acceptable share of failed calls, from 0 to 1
+ * @param window How far back calls are sampled
+ * @param minSamples Calls in the window before the budget is enforced
+ * @param probeInterval Time between probe calls of a degraded operation
+ * @param recoveryProbes Probes in a row within the budget that end a degraded period
+ * @param timeSource Clock for the latencies, the window and the probes
+ */
+class SloController(
+    val latencyBudget: Duration = 1.seconds,
+    val percentile: Double = 0.99,
+    val maxErrorRate: Double = 0.2,
+    val window: Duration = 30.seconds,
+    val minSamples: Int = 20,
+    val probeInterval: Duration = 5.seconds,
+    val recoveryProbes: Int = 3,
+    private val timeSource: TimeSource = TimeSource.Monotonic
+) {
+    init {
+        require(latencyBudget > Duration.ZERO) { "latencyBudget must be positive" }
+        require(percentile > 0.0 && percentile <= 1.0) { "percentile must be between 0 and 1" }
+        require(maxErrorRate >= 0.0 && maxErrorRate < 1.0) { "maxErrorRate must be between 0 and 1" }
+        require(window > Duration.ZERO) { "window must be positive" }
+        require(minSamples > 0) { "minSamples must be positive" }
+        require(recoveryProbes > 0) { "recoveryProbes must be positive" }
+    }
+
+    private class Sample(val at: TimeMark, val latencyNanos: Long, val failed: Boolean)
+
+    private class Operation {
+        val samples = ArrayDeque<Sample>()
+        var mode = SloMode.HEALTHY
+        var transitions = 0
+        var degradedSince: TimeMark? = null
+        var degradedTotal = Duration.ZERO
+        var lastProbe: TimeMark? = null
+        var probesPassed = 0
+        var localAnswers = 0L
+    }
+
+    private val mutex = Mutex()
+    private val operations = LinkedHashMap<String, Operation>()
+
+    /**
+     * Current mode of [operation]
+     */
+    suspend fun mode(operation: String): SloMode = mutex.withLock { operations[operation]?.mode ?: SloMode.HEALTHY }
+
+    /**
+     * Current state of every operation called so far
+     */
+    suspend fun status(): List<SloStatus> = mutex.withLock {
+        operations.map { (name, operation) ->
+            prune(operation)
+            SloStatus(
+                operation = name,
+                mode = operation.mode,
+                latency = latencyPercentile(operation),
+                errorRate = errorRate(operation),
+                samples = operation.samples.size,
+                transitions = operation.transitions,
+                timeDegraded = operation.degradedTotal + (operation.degradedSince?.elapsedNow() ?: Duration.ZERO),
+                localAnswers = operation.localAnswers
+            )
+        }
+    }
+
+    /**
+     * Run [call] for [operation], or answer with [local] while the operation is degraded
+     *
+     * A degraded operation also answers with [local] when its probe fails.
+     * @param local The local answer, or null when there is none
+     * @param isFailure Whether an error of [call] counts against the error budget; other errors,
+     * such as a 404 or a call shed before it was sent, say nothing about the API's health and are
+     * neither sampled nor counted as probes
+     */
+    internal suspend fun <T> guard(
+        operation: String,
+        local: suspend () -> T?,
+        isFailure: (Throwable) -> Boolean,
+        call: suspend () -> T
+    ): T {
+        if (!admit(operation)) {
+            val answer = local()
+            if (answer != null) return answeredLocally(operation, answer)
+        }
+        val mark = timeSource.markNow()
+        val result = try {
+            call()
+        } catch (e: CancellationException) {
+            throw e
+        } catch (e: Throwable) {
+            if (isFailure(e) && record(operation, mark.elapsedNow(), failed = true)) {
+                val answer = local()
+                if (answer != null) return answeredLocally(operation, answer)
+            }
+            throw e
+        }
+        record(operation, mark.elapsedNow(), failed = false)
+        return result
+    }
+
+    /**
+     * Whether a call to [operation] goes upstream: always while healthy, once per probe interval while degraded
+     */
+    private suspend fun admit(operation: String): Boolean {
+        mutex.withLock {
+            val state = operations.getOrPut(operation) { Operation() }
+            if (state.mode == SloMode.HEALTHY) return true
+            val lastProbe = state.lastProbe
+            if (lastProbe != null && lastProbe.elapsedNow() < probeInterval) return false
+            state.lastProbe = timeSource.markNow()
+            return true
+        }
+    }
+
+    private suspend fun <T> answeredLocally(operation: String, answer: T): T {
+        mutex.withLock { operations.getOrPut(operation) { Operation() }.localAnswers++ }
+        return answer
+    }
+
+    /**
+     * Sample one upstream call and update the mode of [operation]
+     * @return Whether the operation is degraded afterwards
+     */
+    private suspend fun record(operation: String, latency: Duration, failed: Boolean): Boolean = mutex.withLock {
+        val state = operations.getOrPut(operation) { Operation() }
+        if (state.mode == SloMode.DEGRADED) {
+            state.probesPassed = if (!failed && latency <= latencyBudget) state.probesPassed + 1 else 0
+            if (state.probesPassed >= recoveryProbes) {
+                state.mode = SloMode.HEALTHY
+                state.transitions++
+                state.degradedTotal += state.degradedSince!!.elapsedNow()
+                state.degradedSince = null
+                state.samples.clear()
+            }
+        } else {
+            state.samples.addLast(Sample(timeSource.markNow(), latency.inWholeNanoseconds, failed))
+            prune(state)
+            if (state.samples.size >= minSamples && breached(state)) {
+                state.mode = SloMode.DEGRADED
+                state.transitions++
+                state.degradedSince = timeSource.markNow()
+                state.lastProbe = state.degradedSince
+                state.probesPassed = 0
+            }
+        }
+        state.mode == SloMode.DEGRADED
+    }
+
+    private fun breached(operation: Operation): Boolean =
+        errorRate(operation) > maxErrorRate || latencyPercentile(operation)!! > latencyBudget
+
+    private fun prune(operation: Operation) {
+        val samples = operation.samples
+        while (samples.isNotEmpty() && (samples.first().at.elapsedNow() > window || samples.size > MAX_SAMPLES)) {
+            samples.removeFirst()
+        }
+    }
+
+    private fun latencyPercentile(operation: Operation): Duration? {
+        val samples = operation.samples
+        if (samples.isEmpty()) return null
+        val sorted = LongArray(samples.size) { samples[it].latencyNanos }.apply { sort() }
+        val rank = ceil(percentile * sorted.size).toInt().coerceIn(1, sorted.size)
+        return sorted[rank - 1].nanoseconds
+    }
+
+    private fun errorRate(operation: Operation): Double {
+        val samples = operation.samples
+        if (samples.isEmpty()) return 0.0
+        return samples.count { it.failed }.toDouble() / samples.size
+    }
+
+    private companion object {
+        // Bounds the window of a busy operation; the percentile only needs recent calls
+        const val MAX_SAMPLES = 1000
+    }
+}
@@ -0,0 +1,17 @@
+package io.github.kotlin.allfunds.networking.data.remote.slo
+
+/**
+ * Whether an API operation is served upstream or from local data
+ */
+enum class SloMode {
+    /**
+     * Calls go to the API
+     */
+    HEALTHY,
+
+    /**
+     * The operation broke its latency or error budget: calls are answered from local data when
+     * there is any, and only probe calls go to the API
+     */
+    DEGRADED
+}
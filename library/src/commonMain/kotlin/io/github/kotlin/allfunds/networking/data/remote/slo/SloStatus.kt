@@ -0,0 +1,26 @@
+package io.github.kotlin.allfunds.networking.data.remote.slo
+
+import kotlin.time.Duration
+
+/**
+ * Current SLO state of one API operation
+ *
+ * @property operation Path of the operation, such as `/search`
+ * @property mode Whether the operation is served upstream or from local data
+ * @property latency Latency percentile of the calls in the window, or null when there are none
+ * @property errorRate Share of the calls in the window that failed, from 0 to 1
+ * @property samples Calls in the window
+ * @property transitions Mode changes so far, into and out of [SloMode.DEGRADED]
+ * @property timeDegraded Total time spent degraded, including the current period
+ * @property localAnswers Calls answered from local data
+ */
+data class SloStatus(
+    val operation: String,
+    val mode: SloMode,
+    val latency: Duration?,
+    val errorRate: Double,
+    val samples: Int,
+    val transitions: Int,
+    val timeDegraded: Duration,
+    val localAnswers: Long
+)
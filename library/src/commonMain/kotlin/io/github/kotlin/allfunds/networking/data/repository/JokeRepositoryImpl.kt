@@ -2,7 +2,10 @@ package io.github.kotlin.allfunds.networking.data.repository
 
 import io.github.kotlin.allfunds.networking.data.remote.ChuckNorrisApi
 import io.github.kotlin.allfunds.networking.domain.model.Joke
+import io.github.kotlin.allfunds.networking.domain.model.JokeSearchResult
+import io.github.kotlin.allfunds.networking.domain.model.SearchProjection
 import io.github.kotlin.allfunds.networking.domain.repository.JokeRepository
+import io.github.kotlin.allfunds.networking.domain.repository.searchBatch
 
 /**
  * Implementation of the JokeRepository
@@ -57,10 +60,41 @@ class JokeRepositoryImpl(
      */
     override suspend fun searchJokes(query: String): Result<List<Joke>> {
         return try {
-            val searchResponse = api.searchJokes(query)
-            Result.success(searchResponse.toDomain())
+            val jokes = api.searchJokeList(query)
+            Result.success(jokes)
         } catch (e: Exception) {
             Result.failure(e)
         }
     }
-}
\ No newline at end of file
+
+    /**
+     * Search for jokes, keeping only the fields of [projection]
+     * @param query The search query
+     * @param projection Fields the caller needs
+     * @return Total number of matches and the projected jokes
+     */
+    override suspend fun searchJokes(query: String, projection: SearchProjection): Result<JokeSearchResult> {
+        return try {
+            Result.success(api.searchJokes(query, projection))
+        } catch (e: Exception) {
+            Result.failure(e)
+        }
+    }
+
+    /**
+     * Run several searches concurrently, see [JokeRepository.searchJokesBatch]
+     *
+     * Jokes an earlier response of the batch found are skipped while decoding the later ones.
+     * @param queries The search queries
+     * @param maxConcurrency Searches sent at once
+     * @return Hits of each query, keyed by the query as given
+     */
+    override suspend fun searchJokesBatch(queries: List<String>, maxConcurrency: Int): Result<Map<String, List<Joke>>> =
+        searchBatch(queries, maxConcurrency) { query, known ->
+            try {
+                Result.success(api.searchJokeList(query, known))
+            } catch (e: Exception) {
+                Result.failure(e)
+            }
+        }
+}
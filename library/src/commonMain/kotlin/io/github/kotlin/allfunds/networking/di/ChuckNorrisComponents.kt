@@ -0,0 +1,65 @@
+package io.github.kotlin.allfunds.networking.di
+
+import io.github.kotlin.allfunds.networking.data.remote.ChuckNorrisApi
+import io.github.kotlin.allfunds.networking.data.repository.JokeRepositoryImpl
+import io.github.kotlin.allfunds.networking.domain.repository.JokeRepository
+import io.github.kotlin.allfunds.networking.domain.usecase.GetCategoriesUseCase
+import io.github.kotlin.allfunds.networking.domain.usecase.GetRandomJokeByCategoryUseCase
+import io.github.kotlin.allfunds.networking.domain.usecase.GetRandomJokeUseCase
+import io.github.kotlin.allfunds.networking.domain.usecase.PageJokesUseCase
+import io.github.kotlin.allfunds.networking.domain.usecase.SearchJokesUseCase
+import io.github.kotlin.allfunds.networking.domain.usecase.StreamRandomJokesUseCase
+import org.koin.core.Koin
+
+/**
+ * The wired object graph behind a [io.github.kotlin.allfunds.networking.ChuckNorrisClient]
+ *
+ * Use cases are stateless, so one graph is shared by every client handle built on it.
+ */
+class ChuckNorrisComponents(
+    val api: ChuckNorrisApi,
+    val getRandomJokeUseCase: GetRandomJokeUseCase,
+    val getRandomJokeByCategoryUseCase: GetRandomJokeByCategoryUseCase,
+    val getCategoriesUseCase: GetCategoriesUseCase,
+    val searchJokesUseCase: SearchJokesUseCase,
+    val streamRandomJokesUseCase: StreamRandomJokesUseCase,
+    val pageJokesUseCase: PageJokesUseCase
+) {
+    companion object {
+        /**
+         * Wire the repository and use cases directly on [api], without any container
+         */
+        fun create(api: ChuckNorrisApi): ChuckNorrisComponents {
+            val repository = JokeRepositoryImpl(api)
+            return ChuckNorrisComponents(
+                api = api,
+                getRandomJokeUseCase = GetRandomJokeUseCase(repository),
+                getRandomJokeByCategoryUseCase = GetRandomJokeByCategoryUseCase(repository),
+                getCategoriesUseCase = GetCategoriesUseCase(repository),
+                searchJokesUseCase = SearchJokesUseCase(repository),
+                streamRandomJokesUseCase = StreamRandomJokesUseCase(repository),
+                pageJokesUseCase = PageJokesUseCase(repository)
+            )
+        }
+
+        /**
+         * Resolve the graph from a Koin container declaring the [networkModule] definitions
+         *
+         * Use cases added after [networkModule] was first published may be missing from an app's own
+         * module; those are built on the container's [JokeRepository], or on the resolved api.
+         */
+        fun from(koin: Koin): ChuckNorrisComponents {
+            val api = koin.get<ChuckNorrisApi>()
+            val repository by lazy { koin.getOrNull<JokeRepository>() ?: JokeRepositoryImpl(api) }
+            return ChuckNorrisComponents(
+                api = api,
+                getRandomJokeUseCase = koin.get(),
+                getRandomJokeByCategoryUseCase = koin.get(),
+                getCategoriesUseCase = koin.get(),
+                searchJokesUseCase = koin.get(),
+                streamRandomJokesUseCase = koin.getOrNull() ?: StreamRandomJokesUseCase(repository),
+                pageJokesUseCase = koin.getOrNull() ?: PageJokesUseCase(repository)
+            )
+        }
+    }
+}
@@ -1,35 +1,87 @@
 package io.github.kotlin.allfunds.networking.di
 
-import org.koin.core.context.startKoin
-import org.koin.core.context.stopKoin
+import io.github.kotlin.allfunds.networking.domain.repository.JokeRepository
+import org.koin.core.Koin
 import org.koin.core.KoinApplication
+import org.koin.core.context.loadKoinModules
+import org.koin.core.context.startKoin
+import org.koin.dsl.koinApplication
+import org.koin.mp.KoinPlatformTools
+import kotlin.concurrent.atomics.AtomicReference
+import kotlin.concurrent.atomics.ExperimentalAtomicApi
 
 /**
  * Initializer for Koin dependency injection
+ *
+ * The library keeps its own Koin container instead of the global one, so it never has to stop
+ * or restart a container an application may be using. Once created, the container lives until
+ * [close] is called. Applications that resolve the library's components from the global Koin,
+ * which [init] populated in earlier versions, call [initGlobal] instead.
  */
+@OptIn(ExperimentalAtomicApi::class)
 object KoinInitializer {
-    private var initialized = false
+    private val application = AtomicReference<KoinApplication?>(null)
     
     /**
      * Initialize Koin with the network module
+     *
+     * Idempotent and safe to call from any thread; after the first call it is a single atomic read.
+     * Definitions are resolved lazily, so this does not create the HTTP client.
      * @return KoinApplication instance
      */
     fun init(): KoinApplication {
-        if (initialized) {
-            stopKoin()
-        }
-        
-        val koinApp = startKoin {
+        application.load()?.let { return it }
+        val created = koinApplication {
             modules(networkModule)
         }
-        
-        initialized = true
-        return koinApp
+        if (application.compareAndSet(null, created)) return created
+        // Another thread won the race; nothing was resolved from ours yet
+        created.close()
+        return application.load()!!
+    }
+
+    /**
+     * Declare the network module in the global Koin, as [init] did in earlier versions
+     *
+     * Starts the global Koin when none is running, and loads the module into the running one
+     * otherwise; the application owns that container and stops it. Clients then resolve their
+     * components from it, see [koin].
+     * @return The global Koin instance
+     */
+    fun initGlobal(): Koin {
+        val global = KoinPlatformTools.defaultContext().getOrNull()
+            ?: return startKoin { modules(networkModule) }.koin
+        loadKoinModules(networkModule)
+        return global
+    }
+
+    /**
+     * Koin instance for the library's components
+     *
+     * A running global Koin that declares them takes precedence, so applications and tests can
+     * provide their own definitions; otherwise the library's container is used.
+     */
+    fun koin(): Koin {
+        val global = KoinPlatformTools.defaultContext().getOrNull()
+        if (global != null && global.getOrNull<JokeRepository>() != null) {
+            return global
+        }
+        return init().koin
     }
     
+    /**
+     * Close the library container, releasing the HTTP engine of its API
+     *
+     * Clients that already resolved their components keep the closed API and fail; the next
+     * [init] creates a new container.
+     */
+    fun close() {
+        application.exchange(null)?.close()
+    }
+
     /**
      * Check if Koin is initialized
      * @return true if Koin is initialized, false otherwise
      */
-    fun isInitialized(): Boolean = initialized
-}
\ No newline at end of file
+    fun isInitialized(): Boolean = application.load() != null
+}
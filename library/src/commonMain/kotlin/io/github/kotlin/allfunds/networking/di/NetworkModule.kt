@@ -7,8 +7,11 @@ import io.github.kotlin.allfunds.networking.domain.repository.JokeRepository
 import io.github.kotlin.allfunds.networking.domain.usecase.GetCategoriesUseCase
 import io.github.kotlin.allfunds.networking.domain.usecase.GetRandomJokeByCategoryUseCase
 import io.github.kotlin.allfunds.networking.domain.usecase.GetRandomJokeUseCase
+import io.github.kotlin.allfunds.networking.domain.usecase.PageJokesUseCase
 import io.github.kotlin.allfunds.networking.domain.usecase.SearchJokesUseCase
+import io.github.kotlin.allfunds.networking.domain.usecase.StreamRandomJokesUseCase
 import org.koin.core.module.Module
+import org.koin.core.module.dsl.onClose
 import org.koin.dsl.module
 
 /**
@@ -16,7 +19,7 @@ import org.koin.dsl.module
  */
 val networkModule = module {
     // API
-    single<ChuckNorrisApi> { ChuckNorrisApiImpl() }
+    single<ChuckNorrisApi> { ChuckNorrisApiImpl() } onClose { it?.close() }
     
     // Repository
     single<JokeRepository> { JokeRepositoryImpl(get()) }
@@ -26,4 +29,6 @@ val networkModule = module {
     factory { GetRandomJokeByCategoryUseCase(get()) }
     factory { GetCategoriesUseCase(get()) }
     factory { SearchJokesUseCase(get()) }
+    factory { StreamRandomJokesUseCase(get()) }
+    factory { PageJokesUseCase(get()) }
 }
\ No newline at end of file
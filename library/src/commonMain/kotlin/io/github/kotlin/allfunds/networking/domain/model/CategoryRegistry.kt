@@ -0,0 +1,55 @@
+package io.github.kotlin.allfunds.networking.domain.model
+
+/**
+ * Interned registry of the categories served by the API
+ *
+ * Each known category maps to one bit, so a joke's categories fit in an [Int] as long as they
+ * are known and listed in registry order, which is how the API returns them.
+ */
+internal object CategoryRegistry {
+    /**
+     * Known categories, in the alphabetical order used by the API
+     */
+    val names: List<String> = listOf(
+        "animal", "career", "celebrity", "dev", "explicit", "fashion", "food", "history",
+        "money", "movie", "music", "political", "religion", "science", "sport", "travel"
+    )
+
+    private val singletons: List<List<String>> = names.map { listOf(it) }
+
+    /**
+     * Bitset of [categories], or null when it cannot reproduce the list exactly
+     */
+    fun encode(categories: List<String>): Int? {
+        var bits = 0
+        var previous = -1
+        for (category in categories) {
+            val index = names.indexOf(category)
+            if (index <= previous) return null
+            bits = bits or (1 shl index)
+            previous = index
+        }
+        return bits
+    }
+
+    /**
+     * Categories of a bitset, using the interned names
+     */
+    fun decode(bits: Int): List<String> {
+        if (bits == 0) return emptyList()
+        if (bits and (bits - 1) == 0) return singletons[bits.countTrailingZeroBits()]
+        val categories = ArrayList<String>(bits.countOneBits())
+        for (index in names.indices) {
+            if (bits and (1 shl index) != 0) categories += names[index]
+        }
+        return categories
+    }
+
+    /**
+     * The interned instance of [category] when it is known
+     */
+    fun intern(category: String): String {
+        val index = names.indexOf(category)
+        return if (index >= 0) names[index] else category
+    }
+}
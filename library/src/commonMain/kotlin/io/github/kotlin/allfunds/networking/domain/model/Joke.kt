@@ -2,10 +2,197 @@ package io.github.kotlin.allfunds.networking.domain.model
 
 /**
  * Domain model representing a Chuck Norris joke
+ *
+ * Stored compactly, since large joke lists are kept in memory: the id is packed into 132 bits,
+ * the categories into a bitset over [CategoryRegistry], and the url is derived from the id on
+ * access. Ids, urls and category lists that do not fit this layout are kept as given, so every
+ * property returns exactly what was passed to the constructor.
+ *
+ * Jokes decoded with lazy text keep [value] as UTF-8 bytes and decode it on first access;
+ * [valueLength] and [valuePrefix] answer without a full decode.
  */
-data class Joke(
-    val id: String,
-    val value: String,
-    val url: String,
+class Joke private constructor(
+    private val idHigh: Long,
+    private val idLow: Long,
+    private val idTail: Int,
+    private var text: Any,
+    private val textOffset: Int,
+    private val textLength: Int,
+    private val categoryBits: Int,
+    private val extras: Extras?
+) {
+    /**
+     * Parts of a joke that do not fit the compact layout
+     */
+    private data class Extras(
+        val id: String?,
+        val url: String?,
+        val categories: List<String>?
+    )
+
+    private class Layout(id: String, url: String, categories: List<String>) {
+        val packed = JokeIdCodec.canPack(id)
+        val idHigh = if (packed) JokeIdCodec.high(id) else 0L
+        val idLow = if (packed) JokeIdCodec.low(id) else 0L
+        val idTail = if (packed) JokeIdCodec.tail(id) else JokeIdCodec.NOT_PACKED
+        val bits = CategoryRegistry.encode(categories)
+        val extras: Extras? = run {
+            val extraId = if (packed) null else id
+            val extraUrl = if (url == URL_PREFIX + id) null else url
+            val extraCategories = if (bits != null) null else categories.map { CategoryRegistry.intern(it) }
+            if (extraId == null && extraUrl == null && extraCategories == null) {
+                null
+            } else {
+                Extras(extraId, extraUrl, extraCategories)
+            }
+        }
+    }
+
+    private constructor(layout: Layout, text: Any, textOffset: Int, textLength: Int) : this(
+        idHigh = layout.idHigh,
+        idLow = layout.idLow,
+        idTail = layout.idTail,
+        text = text,
+        textOffset = textOffset,
+        textLength = textLength,
+        categoryBits = layout.bits ?: 0,
+        extras = layout.extras
+    )
+
+    constructor(
+        id: String,
+        value: String,
+        url: String,
+        categories: List<String>
+    ) : this(Layout(id, url, categories), value, 0, value.length)
+
+    /**
+     * Joke whose text is the UTF-8 slice [textOffset] to [textOffset] + [textLength] of [utf8],
+     * decoded on first access. [utf8] must not be modified afterwards.
+     */
+    internal constructor(
+        id: String,
+        utf8: ByteArray,
+        textOffset: Int,
+        textLength: Int,
+        url: String,
+        categories: List<String>
+    ) : this(Layout(id, url, categories), utf8, textOffset, textLength)
+
+    /**
+     * Joke text
+     */
+    val value: String
+        get() {
+            val current = text
+            if (current is String) return current
+            // Racing readers decode the same bytes, so publishing either result is fine
+            val decoded = (current as ByteArray).decodeToString(textOffset, textOffset + textLength)
+            text = decoded
+            return decoded
+        }
+
+    /**
+     * Whether [value] has been decoded, or was given as a String
+     */
+    internal val isValueDecoded: Boolean
+        get() = text is String
+
+    /**
+     * Length of [value] in UTF-16 code units, without decoding it
+     */
+    val valueLength: Int
+        get() = when (val current = text) {
+            is String -> current.length
+            else -> Utf8Text.length(current as ByteArray, textOffset, textLength)
+        }
+
+    /**
+     * The first [maxChars] characters of [value], decoding only those
+     */
+    fun valuePrefix(maxChars: Int): String = when (val current = text) {
+        is String -> current.take(maxChars)
+        else -> Utf8Text.prefix(current as ByteArray, textOffset, textLength, maxChars)
+    }
+
+    /**
+     * Joke id, as returned by the API
+     */
+    val id: String
+        get() = extras?.id ?: JokeIdCodec.unpack(idHigh, idLow, idTail)
+
+    /**
+     * Joke URL on the API website
+     */
+    val url: String
+        get() = extras?.url ?: (URL_PREFIX + id)
+
+    /**
+     * Categories of the joke, possibly empty
+     */
     val categories: List<String>
-)
\ No newline at end of file
+        get() = extras?.categories ?: CategoryRegistry.decode(categoryBits)
+
+    operator fun component1(): String = id
+
+    operator fun component2(): String = value
+
+    operator fun component3(): String = url
+
+    operator fun component4(): List<String> = categories
+
+    fun copy(
+        id: String = this.id,
+        value: String = this.value,
+        url: String = this.url,
+        categories: List<String> = this.categories
+    ): Joke = Joke(id, value, url, categories)
+
+    /**
+     * Jokes are equal when every field is; the text is compared last, once the cheap fields match
+     */
+    override fun equals(other: Any?): Boolean {
+        if (this === other) return true
+        if (other !is Joke) return false
+        return idHigh == other.idHigh &&
+            idLow == other.idLow &&
+            idTail == other.idTail &&
+            categoryBits == other.categoryBits &&
+            extras == other.extras &&
+            sameText(other)
+    }
+
+    /**
+     * Whether the texts are equal, comparing the bytes when both are still undecoded
+     */
+    private fun sameText(other: Joke): Boolean {
+        val mine = text
+        val theirs = other.text
+        if (mine is ByteArray && theirs is ByteArray && textLength == other.textLength) {
+            var i = 0
+            while (i < textLength && mine[textOffset + i] == theirs[other.textOffset + i]) i++
+            if (i == textLength) return true
+        }
+        return value == other.value
+    }
+
+    /**
+     * Hash of the id only, so hashing never reads the text
+     */
+    override fun hashCode(): Int {
+        var result = (idHigh xor (idHigh ushr 32)).toInt()
+        result = 31 * result + (idLow xor (idLow ushr 32)).toInt()
+        result = 31 * result + idTail
+        result = 31 * result + (extras?.id?.hashCode() ?: 0)
+        return result
+    }
+
+    override fun toString(): String = "Joke(id=$id, value=$value, url=$url, categories=$categories)"
+
+    internal companion object {
+        /**
+         * Prefix of the url of every API joke, followed by its id
+         */
+        const val URL_PREFIX = "https://api.chucknorris.io/jokes/"
+    }
+}
@@ -0,0 +1,55 @@
+package io.github.kotlin.allfunds.networking.domain.model
+
+/**
+ * Packs the 22 character base64url ids of the API into 132 bits
+ *
+ * Characters 0-9 go in the high long, 10-19 in the low long and 20-21 in the tail int, six
+ * bits each, most significant first.
+ */
+internal object JokeIdCodec {
+    const val PACKED_LENGTH = 22
+    const val NOT_PACKED = -1
+
+    private const val ALPHABET = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_"
+    private const val BITS = 6
+    private const val LONG_CHARS = 10
+
+    private val indices = IntArray(128) { -1 }.also { table ->
+        ALPHABET.forEachIndexed { index, char -> table[char.code] = index }
+    }
+
+    /**
+     * Whether [id] fits the packed form
+     */
+    fun canPack(id: String): Boolean =
+        id.length == PACKED_LENGTH && id.all { it.code < indices.size && indices[it.code] >= 0 }
+
+    fun high(id: String): Long = pack(id, 0, LONG_CHARS)
+
+    fun low(id: String): Long = pack(id, LONG_CHARS, 2 * LONG_CHARS)
+
+    fun tail(id: String): Int = pack(id, 2 * LONG_CHARS, PACKED_LENGTH).toInt()
+
+    /**
+     * Rebuild the textual id from its packed parts
+     */
+    fun unpack(high: Long, low: Long, tail: Int): String = buildString(PACKED_LENGTH) {
+        appendChars(high, LONG_CHARS)
+        appendChars(low, LONG_CHARS)
+        appendChars(tail.toLong(), PACKED_LENGTH - 2 * LONG_CHARS)
+    }
+
+    private fun pack(id: String, from: Int, to: Int): Long {
+        var packed = 0L
+        for (i in from until to) {
+            packed = (packed shl BITS) or indices[id[i].code].toLong()
+        }
+        return packed
+    }
+
+    private fun StringBuilder.appendChars(packed: Long, count: Int) {
+        for (i in count - 1 downTo 0) {
+            append(ALPHABET[((packed ushr (i * BITS)) and 0x3F).toInt()])
+        }
+    }
+}
@@ -0,0 +1,12 @@
+package io.github.kotlin.allfunds.networking.domain.model
+
+/**
+ * Result of a joke search
+ *
+ * @property total Total number of matches reported by the API
+ * @property jokes Matching jokes, holding the fields of the requested [SearchProjection]
+ */
+data class JokeSearchResult(
+    val total: Int,
+    val jokes: List<Joke>
+)
@@ -0,0 +1,26 @@
+package io.github.kotlin.allfunds.networking.domain.model
+
+/**
+ * Fields of a joke search a caller needs
+ */
+enum class SearchProjection {
+    /**
+     * Only the total number of matches, no jokes
+     */
+    COUNT_ONLY,
+
+    /**
+     * Jokes with their id and the url derived from it; texts are empty and categories are not read
+     */
+    IDS,
+
+    /**
+     * Jokes with id and text; categories are not read
+     */
+    IDS_AND_TEXT,
+
+    /**
+     * Complete jokes
+     */
+    FULL
+}
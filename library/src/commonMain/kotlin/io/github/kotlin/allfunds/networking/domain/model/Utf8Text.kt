@@ -0,0 +1,48 @@
+package io.github.kotlin.allfunds.networking.domain.model
+
+/**
+ * Length and prefix queries on UTF-8 text, measured in UTF-16 code units like [String]
+ */
+internal object Utf8Text {
+
+    /**
+     * Number of UTF-16 code units of the text, without decoding it
+     */
+    fun length(bytes: ByteArray, offset: Int, length: Int): Int {
+        var units = 0
+        for (index in offset until offset + length) {
+            val byte = bytes[index].toInt() and 0xFF
+            when {
+                byte and 0xC0 == 0x80 -> Unit // continuation byte
+                byte >= 0xF0 -> units += 2 // encoded as a surrogate pair
+                else -> units++
+            }
+        }
+        return units
+    }
+
+    /**
+     * Decode at most [maxChars] UTF-16 code units from the start of the text
+     *
+     * Never splits a surrogate pair, so the result may be one unit shorter than [maxChars].
+     */
+    fun prefix(bytes: ByteArray, offset: Int, length: Int, maxChars: Int): String {
+        val end = offset + length
+        var units = 0
+        var index = offset
+        while (index < end) {
+            val byte = bytes[index].toInt() and 0xFF
+            val size = when {
+                byte < 0x80 -> 1
+                byte < 0xE0 -> 2
+                byte < 0xF0 -> 3
+                else -> 4
+            }
+            val width = if (size == 4) 2 else 1
+            if (units + width > maxChars) break
+            units += width
+            index = minOf(index + size, end)
+        }
+        return bytes.decodeToString(offset, index)
+    }
+}
@@ -0,0 +1,18 @@
+package io.github.kotlin.allfunds.networking.domain.paging
+
+/**
+ * The jokes a [JokePager] pages through
+ */
+sealed interface JokeFeed {
+    /**
+     * An endless feed of random jokes
+     * @property category Category of the jokes, or null for any
+     */
+    data class Random(val category: String? = null) : JokeFeed
+
+    /**
+     * The results of a search
+     * @property query The search query (must be at least 3 characters)
+     */
+    data class Search(val query: String) : JokeFeed
+}
@@ -0,0 +1,16 @@
+package io.github.kotlin.allfunds.networking.domain.paging
+
+import io.github.kotlin.allfunds.networking.domain.model.Joke
+
+/**
+ * One page loaded by a [JokePageSource]
+ *
+ * @property jokes Jokes of the page, fewer than the page size only on the last page
+ * @property last Whether no page follows this one
+ * @property itemCount Total number of jokes of the source, when the source knows it
+ */
+data class JokePage(
+    val jokes: List<Joke>,
+    val last: Boolean,
+    val itemCount: Int? = null
+)
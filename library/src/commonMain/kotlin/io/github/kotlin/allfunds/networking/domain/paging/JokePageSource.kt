@@ -0,0 +1,71 @@
+package io.github.kotlin.allfunds.networking.domain.paging
+
+import io.github.kotlin.allfunds.networking.domain.model.Joke
+import kotlinx.coroutines.async
+import kotlinx.coroutines.awaitAll
+import kotlinx.coroutines.coroutineScope
+import kotlinx.coroutines.sync.Mutex
+import kotlinx.coroutines.sync.withLock
+
+/**
+ * Loads the pages of a [JokePager]
+ */
+interface JokePageSource {
+    /**
+     * Load one page
+     * @param page Index of the page, from 0
+     * @param pageSize Jokes per page
+     * @return The page, or the error that prevented loading it
+     */
+    suspend fun load(page: Int, pageSize: Int): Result<JokePage>
+
+    /**
+     * Drop anything kept from earlier loads, so the next loads fetch fresh data
+     */
+    suspend fun invalidate() {}
+}
+
+/**
+ * Endless pages of random jokes, each one filled by concurrent requests
+ *
+ * Random jokes cannot be fetched again by index, so a page that was dropped and is loaded again
+ * holds different jokes.
+ * @param randomJoke Fetches one random joke
+ */
+class RandomJokePageSource(
+    private val randomJoke: suspend () -> Result<Joke>
+) : JokePageSource {
+    override suspend fun load(page: Int, pageSize: Int): Result<JokePage> = coroutineScope {
+        val results = List(pageSize) { async { randomJoke() } }.awaitAll()
+        val jokes = ArrayList<Joke>(pageSize)
+        for (result in results) {
+            jokes += result.getOrElse { return@coroutineScope Result.failure(it) }
+        }
+        Result.success(JokePage(jokes, last = false))
+    }
+}
+
+/**
+ * Pages of the results of one search
+ *
+ * The API returns every match in one response, so the search runs and is decoded once, on the
+ * first load, and later pages are slices of its result until [invalidate].
+ * @param search Runs the search
+ */
+class SearchJokePageSource(
+    private val search: suspend () -> Result<List<Joke>>
+) : JokePageSource {
+    private val mutex = Mutex()
+    private var results: List<Joke>? = null
+
+    override suspend fun load(page: Int, pageSize: Int): Result<JokePage> {
+        val jokes = mutex.withLock {
+            results ?: search().getOrElse { return Result.failure(it) }.also { results = it }
+        }
+        val from = (page * pageSize).coerceAtMost(jokes.size)
+        val to = (from + pageSize).coerceAtMost(jokes.size)
+        return Result.success(JokePage(jokes.subList(from, to).toList(), last = to == jokes.size, itemCount = jokes.size))
+    }
+
+    override suspend fun invalidate() = mutex.withLock { results = null }
+}
@@ -0,0 +1,148 @@
+package io.github.kotlin.allfunds.networking.domain.paging
+
+import kotlinx.coroutines.CoroutineScope
+import kotlinx.coroutines.Job
+import kotlinx.coroutines.flow.MutableStateFlow
+import kotlinx.coroutines.flow.StateFlow
+import kotlinx.coroutines.flow.asStateFlow
+import kotlinx.coroutines.flow.update
+import kotlinx.coroutines.job
+import kotlinx.coroutines.launch
+import kotlinx.coroutines.sync.Mutex
+import kotlinx.coroutines.sync.withLock
+import kotlin.math.abs
+
+/**
+ * Pages through a [JokePageSource] for an infinite list
+ *
+ * The list reports the joke it shows with [onVisible]. The pager then loads every page within
+ * [PagingConfig.prefetchDistance] jokes of it, so the next page is ready before the list reaches
+ * it, and drops the pages farthest from it beyond [PagingConfig.maxPages], so memory stays the
+ * same however far the list scrolls. Loads of dropped pages are cancelled.
+ *
+ * Loads run in [scope]; cancel it to stop the pager.
+ *
+ * @param source Loads the pages
+ * @param scope Scope the loads run in
+ * @param config Page size, prefetch distance and pages held
+ */
+class JokePager(
+    private val source: JokePageSource,
+    private val scope: CoroutineScope,
+    val config: PagingConfig = PagingConfig()
+) {
+    private val mutex = Mutex()
+    private val loads = HashMap<Int, Job>()
+    private var visible = 0
+
+    private val _state = MutableStateFlow(PagingState(emptyMap(), config.pageSize))
+
+    /**
+     * Loaded pages, loads in flight and the last error
+     */
+    val state: StateFlow<PagingState> = _state.asStateFlow()
+
+    /**
+     * Report the joke the list shows, loading the pages around it
+     * @param index Position of the joke, from 0
+     */
+    fun onVisible(index: Int) {
+        require(index >= 0) { "index must not be negative" }
+        scope.launch {
+            mutex.withLock {
+                visible = index
+                fill()
+            }
+        }
+    }
+
+    /**
+     * Clear the error of a failed load and load the missing pages again
+     */
+    fun retry() {
+        scope.launch {
+            mutex.withLock {
+                _state.update { it.copy(error = null) }
+                fill()
+            }
+        }
+    }
+
+    /**
+     * Drop every page and reload the ones around the visible joke from fresh data
+     */
+    fun invalidate() {
+        scope.launch {
+            mutex.withLock {
+                loads.values.forEach { it.cancel() }
+                loads.clear()
+                source.invalidate()
+                _state.value = PagingState(emptyMap(), config.pageSize)
+                fill()
+            }
+        }
+    }
+
+    /**
+     * Start the loads of the missing pages around the visible joke, then drop the far ones
+     */
+    private fun fill() {
+        val current = _state.value
+        if (current.error != null) return
+        val pageSize = config.pageSize
+        val first = (visible - config.prefetchDistance).coerceAtLeast(0) / pageSize
+        var last = (visible + config.prefetchDistance) / pageSize
+        current.lastPage?.let { last = minOf(last, it) }
+        for (page in first..last) {
+            if (page !in current.pages && page !in loads) load(page)
+        }
+        evict()
+    }
+
+    private fun load(page: Int) {
+        _state.update { it.copy(loading = it.loading + page) }
+        loads[page] = scope.launch {
+            val self = coroutineContext.job
+            val result = source.load(page, config.pageSize)
+            mutex.withLock {
+                // Dropped or invalidated while loading
+                if (loads[page] !== self) return@withLock
+                loads.remove(page)
+                result.fold(
+                    onSuccess = { loaded -> loaded(page, loaded) },
+                    onFailure = { error -> _state.update { it.copy(loading = it.loading - page, error = error) } }
+                )
+                fill()
+            }
+        }
+    }
+
+    private fun loaded(page: Int, loaded: JokePage) {
+        _state.update { current ->
+            val itemCount = when {
+                loaded.itemCount != null -> loaded.itemCount
+                loaded.last -> page * config.pageSize + loaded.jokes.size
+                else -> current.itemCount
+            }
+            val pages = current.pages + (page to loaded.jokes)
+            val lastPage = itemCount?.let { maxOf(it - 1, 0) / config.pageSize }
+            current.copy(
+                pages = if (lastPage == null) pages else pages.filterKeys { it <= lastPage },
+                loading = current.loading - page,
+                itemCount = itemCount
+            )
+        }
+    }
+
+    /**
+     * Drop the loaded and loading pages farthest from the visible joke beyond [PagingConfig.maxPages]
+     */
+    private fun evict() {
+        val center = visible / config.pageSize
+        val held = (_state.value.pages.keys + loads.keys).sortedBy { abs(it - center) }
+        val dropped = held.drop(config.maxPages).toSet()
+        if (dropped.isEmpty()) return
+        dropped.forEach { loads.remove(it)?.cancel() }
+        _state.update { it.copy(pages = it.pages - dropped, loading = it.loading - dropped) }
+    }
+}
@@ -0,0 +1,22 @@
+package io.github.kotlin.allfunds.networking.domain.paging
+
+/**
+ * Page size, prefetching and memory bounds of a [JokePager]
+ *
+ * @property pageSize Jokes per page
+ * @property prefetchDistance Jokes before and after the visible one that are loaded ahead
+ * @property maxPages Pages held in memory at once; the pages farthest from the visible one are dropped first
+ */
+data class PagingConfig(
+    val pageSize: Int = 20,
+    val prefetchDistance: Int = pageSize,
+    val maxPages: Int = 5
+) {
+    init {
+        require(pageSize > 0) { "pageSize must be positive" }
+        require(prefetchDistance >= 0) { "prefetchDistance must not be negative" }
+        require(maxPages >= 2 * ((prefetchDistance + pageSize - 1) / pageSize) + 1) {
+            "maxPages must hold the pages within prefetchDistance on both sides of the visible one"
+        }
+    }
+}
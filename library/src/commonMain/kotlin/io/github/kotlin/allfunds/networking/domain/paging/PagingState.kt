@@ -0,0 +1,31 @@
+package io.github.kotlin.allfunds.networking.domain.paging
+
+import io.github.kotlin.allfunds.networking.domain.model.Joke
+
+/**
+ * What a [JokePager] holds at one point in time
+ *
+ * @property pages Loaded pages by index; pages far from the visible joke are dropped
+ * @property pageSize Jokes per page
+ * @property loading Indexes of the pages being loaded
+ * @property itemCount Total number of jokes once the last page has been loaded, null while more may follow
+ * @property error Error of the last failed load; loading stops until [JokePager.retry]
+ */
+data class PagingState(
+    val pages: Map<Int, List<Joke>>,
+    val pageSize: Int,
+    val loading: Set<Int> = emptySet(),
+    val itemCount: Int? = null,
+    val error: Throwable? = null
+) {
+    /**
+     * Index of the last page, once it is known
+     */
+    val lastPage: Int?
+        get() = itemCount?.let { maxOf(it - 1, 0) / pageSize }
+
+    /**
+     * The joke at [index], or null when its page is not loaded
+     */
+    operator fun get(index: Int): Joke? = pages[index / pageSize]?.getOrNull(index % pageSize)
+}
@@ -1,6 +1,8 @@
 package io.github.kotlin.allfunds.networking.domain.repository
 
 import io.github.kotlin.allfunds.networking.domain.model.Joke
+import io.github.kotlin.allfunds.networking.domain.model.JokeSearchResult
+import io.github.kotlin.allfunds.networking.domain.model.SearchProjection
 
 /**
  * Repository interface for accessing Chuck Norris jokes
@@ -39,4 +41,41 @@ interface JokeRepository {
      */
     @Throws(Exception::class)
     suspend fun searchJokes(query: String): Result<List<Joke>>
+
+    /**
+     * Search for jokes, keeping only the fields of [projection]
+     * @param query The search query
+     * @param projection Fields the caller needs
+     * @return Total number of matches and the projected jokes
+     * @throws Exception if the request fails
+     */
+    @Throws(Exception::class)
+    suspend fun searchJokes(query: String, projection: SearchProjection): Result<JokeSearchResult> =
+        searchJokes(query).map { jokes ->
+            JokeSearchResult(jokes.size, if (projection == SearchProjection.COUNT_ONLY) emptyList() else jokes)
+        }
+
+    /**
+     * Run several searches concurrently, merging their results
+     *
+     * Identical queries are sent once. A joke found by several queries is the same [Joke]
+     * instance in each of their lists.
+     * @param queries The search queries
+     * @param maxConcurrency Searches sent at once
+     * @return Hits of each query, keyed by the query as given
+     * @throws Exception if a search fails
+     */
+    @Throws(Exception::class)
+    suspend fun searchJokesBatch(
+        queries: List<String>,
+        maxConcurrency: Int = DEFAULT_BATCH_CONCURRENCY
+    ): Result<Map<String, List<Joke>>> =
+        searchBatch(queries, maxConcurrency) { query, _ -> searchJokes(query) }
+
+    companion object {
+        /**
+         * Searches a batch sends at once unless the caller says otherwise
+         */
+        const val DEFAULT_BATCH_CONCURRENCY = 4
+    }
 }
\ No newline at end of file
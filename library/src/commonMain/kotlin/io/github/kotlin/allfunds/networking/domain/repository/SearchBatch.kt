@@ -0,0 +1,70 @@
+package io.github.kotlin.allfunds.networking.domain.repository
+
+import io.github.kotlin.allfunds.networking.domain.model.Joke
+import kotlinx.coroutines.CancellationException
+import kotlinx.coroutines.async
+import kotlinx.coroutines.awaitAll
+import kotlinx.coroutines.coroutineScope
+import kotlinx.coroutines.sync.Mutex
+import kotlinx.coroutines.sync.Semaphore
+import kotlinx.coroutines.sync.withLock
+import kotlinx.coroutines.sync.withPermit
+import kotlin.concurrent.Volatile
+
+/**
+ * Run several searches as one batch, see [JokeRepository.searchJokesBatch]
+ *
+ * Identical queries are sent once. Queries differing only in case or whitespace, or containing
+ * one another, are all sent, since only the API knows how it matches them.
+ * @param queries Queries as given by the caller
+ * @param maxConcurrency Searches sent at once
+ * @param search Runs one search, given the jokes earlier responses of the batch found
+ * @return Hits of every query of [queries]; the same joke is the same instance in every list
+ */
+internal suspend fun searchBatch(
+    queries: List<String>,
+    maxConcurrency: Int,
+    search: suspend (query: String, known: (id: String) -> Joke?) -> Result<List<Joke>>
+): Result<Map<String, List<Joke>>> {
+    require(maxConcurrency > 0) { "maxConcurrency must be positive" }
+    val shared = SharedJokes()
+    val permits = Semaphore(maxConcurrency)
+    val responses = try {
+        coroutineScope {
+            queries.distinct().map { query ->
+                async { permits.withPermit { query to shared.share(search(query, shared::get).getOrThrow()) } }
+            }.awaitAll()
+        }
+    } catch (e: CancellationException) {
+        throw e
+    } catch (e: Exception) {
+        return Result.failure(e)
+    }
+    return Result.success(responses.toMap())
+}
+
+/**
+ * Jokes found so far by a batch, the first instance of each standing for it in every list
+ *
+ * Searches read it while they decode, possibly on other threads, so it is replaced rather than
+ * modified and reads take no lock.
+ */
+private class SharedJokes {
+    private val mutex = Mutex()
+
+    @Volatile
+    private var jokes: Map<String, Joke> = emptyMap()
+
+    fun get(id: String): Joke? = jokes[id]
+
+    /**
+     * Add the new jokes of [found]
+     * @return [found], with the jokes found earlier replaced by their first instance
+     */
+    suspend fun share(found: List<Joke>): List<Joke> = mutex.withLock {
+        val merged = HashMap(jokes)
+        val result = found.map { merged.getOrPut(it.id) { it } }
+        jokes = merged
+        result
+    }
+}
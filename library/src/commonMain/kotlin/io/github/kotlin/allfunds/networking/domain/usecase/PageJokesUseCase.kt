@@ -0,0 +1,36 @@
+package io.github.kotlin.allfunds.networking.domain.usecase
+
+import io.github.kotlin.allfunds.networking.domain.paging.JokeFeed
+import io.github.kotlin.allfunds.networking.domain.paging.JokePager
+import io.github.kotlin.allfunds.networking.domain.paging.PagingConfig
+import io.github.kotlin.allfunds.networking.domain.paging.RandomJokePageSource
+import io.github.kotlin.allfunds.networking.domain.paging.SearchJokePageSource
+import io.github.kotlin.allfunds.networking.domain.repository.JokeRepository
+import kotlinx.coroutines.CoroutineScope
+
+/**
+ * Use case for paging through random jokes or search results
+ */
+class PageJokesUseCase(
+    private val repository: JokeRepository
+) {
+    private val searchJokes = SearchJokesUseCase(repository)
+
+    /**
+     * Execute the use case
+     * @param feed The jokes to page through
+     * @param scope Scope the page loads run in
+     * @param config Page size, prefetch distance and pages held
+     * @return A pager that loads nothing until a joke is reported visible
+     */
+    operator fun invoke(feed: JokeFeed, scope: CoroutineScope, config: PagingConfig = PagingConfig()): JokePager {
+        val source = when (feed) {
+            is JokeFeed.Random -> RandomJokePageSource {
+                val category = feed.category
+                if (category == null) repository.getRandomJoke() else repository.getRandomJokeByCategory(category)
+            }
+            is JokeFeed.Search -> SearchJokePageSource { searchJokes(feed.query) }
+        }
+        return JokePager(source, scope, config)
+    }
+}
@@ -1,6 +1,8 @@
 package io.github.kotlin.allfunds.networking.domain.usecase
 
 import io.github.kotlin.allfunds.networking.domain.model.Joke
+import io.github.kotlin.allfunds.networking.domain.model.JokeSearchResult
+import io.github.kotlin.allfunds.networking.domain.model.SearchProjection
 import io.github.kotlin.allfunds.networking.domain.repository.JokeRepository
 
 /**
@@ -15,9 +17,39 @@ class SearchJokesUseCase(
      * @return Result containing a list of jokes matching the query or an exception
      */
     suspend operator fun invoke(query: String): Result<List<Joke>> {
+        validate(query)?.let { return Result.failure(it) }
+        return repository.searchJokes(query)
+    }
+
+    /**
+     * Execute the use case, keeping only the fields of [projection]
+     * @param query The search query
+     * @param projection Fields the caller needs
+     * @return Result containing the total and the projected jokes or an exception
+     */
+    suspend operator fun invoke(query: String, projection: SearchProjection): Result<JokeSearchResult> {
+        validate(query)?.let { return Result.failure(it) }
+        return repository.searchJokes(query, projection)
+    }
+
+    /**
+     * Execute the use case for several queries at once, see [JokeRepository.searchJokesBatch]
+     * @param queries The search queries
+     * @param maxConcurrency Searches sent at once
+     * @return Result containing the hits of each query or an exception
+     */
+    suspend operator fun invoke(
+        queries: List<String>,
+        maxConcurrency: Int = JokeRepository.DEFAULT_BATCH_CONCURRENCY
+    ): Result<Map<String, List<Joke>>> {
+        queries.firstNotNullOfOrNull { validate(it) }?.let { return Result.failure(it) }
+        return repository.searchJokesBatch(queries, maxConcurrency)
+    }
+
+    private fun validate(query: String): IllegalArgumentException? {
         if (query.length < 3) {
-            return Result.failure(IllegalArgumentException("Search query must be at least 3 characters long"))
+            return IllegalArgumentException("Search query must be at least 3 characters long")
         }
-        return repository.searchJokes(query)
+        return null
     }
 }
\ No newline at end of file
@@ -0,0 +1,83 @@
+package io.github.kotlin.allfunds.networking.domain.usecase
+
+import io.github.kotlin.allfunds.networking.domain.model.Joke
+import io.github.kotlin.allfunds.networking.domain.repository.JokeRepository
+import kotlinx.coroutines.delay
+import kotlinx.coroutines.flow.Flow
+import kotlinx.coroutines.flow.buffer
+import kotlinx.coroutines.flow.flow
+import kotlin.time.Duration
+import kotlin.time.Duration.Companion.seconds
+import kotlin.time.TimeMark
+import kotlin.time.TimeSource
+
+/**
+ * Use case for streaming random jokes
+ *
+ * @param timeSource Clock the requests are paced by
+ */
+class StreamRandomJokesUseCase(
+    private val repository: JokeRepository,
+    private val timeSource: TimeSource = TimeSource.Monotonic
+) {
+    /**
+     * Execute the use case
+     *
+     * The returned flow is cold: each collection fetches its own jokes. The next joke is fetched
+     * while the collector handles the current one, and up to [prefetch] more wait in a buffer;
+     * once the buffer is full, fetching waits for the collector. Cancelling the collection
+     * cancels the request in flight and stops fetching. A failed request ends the flow with
+     * its error.
+     *
+     * @param category Category of the jokes, or null for any
+     * @param targetRate Most requests started per second, or null to fetch as fast as the collector takes jokes
+     * @param prefetch Jokes fetched ahead of the collector
+     * @param dedupWindow A joke seen in the last [dedupWindow] jokes is fetched again, unless
+     * [MAX_REPEATS] fetches in a row return seen jokes, meaning the category has fewer jokes than the window
+     * @param onRequest Called as each request starts, e.g. to trace it
+     * @return Random jokes, without repeats within the window
+     */
+    operator fun invoke(
+        category: String? = null,
+        targetRate: Double? = null,
+        prefetch: Int = 1,
+        dedupWindow: Int = 50,
+        onRequest: () -> Unit = {}
+    ): Flow<Joke> {
+        require(targetRate == null || targetRate > 0.0) { "targetRate must be positive" }
+        require(prefetch >= 0) { "prefetch must not be negative" }
+        require(dedupWindow >= 0) { "dedupWindow must not be negative" }
+        val interval = targetRate?.let { 1.seconds / it } ?: Duration.ZERO
+        return flow {
+            val recent = ArrayDeque<String>()
+            val seen = HashSet<String>()
+            var lastStart: TimeMark? = null
+            var repeats = 0
+            while (true) {
+                val wait = lastStart?.let { interval - it.elapsedNow() } ?: Duration.ZERO
+                if (wait.isPositive()) delay(wait)
+                lastStart = timeSource.markNow()
+                onRequest()
+                val result = if (category == null) repository.getRandomJoke() else repository.getRandomJokeByCategory(category)
+                val joke = result.getOrThrow()
+                if (joke.id in seen && repeats < MAX_REPEATS) {
+                    repeats++
+                    continue
+                }
+                repeats = 0
+                if (dedupWindow > 0 && seen.add(joke.id)) {
+                    recent.addLast(joke.id)
+                    if (recent.size > dedupWindow) seen.remove(recent.removeFirst())
+                }
+                emit(joke)
+            }
+        }.buffer(prefetch)
+    }
+
+    companion object {
+        /**
+         * Seen jokes fetched in a row before one is let through
+         */
+        const val MAX_REPEATS = 3
+    }
+}
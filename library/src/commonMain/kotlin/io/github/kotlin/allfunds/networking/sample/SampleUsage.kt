@@ -1,6 +1,7 @@
 package io.github.kotlin.allfunds.networking.sample
 
 import io.github.kotlin.allfunds.networking.ChuckNorrisClient
+import io.github.kotlin.allfunds.networking.ChuckNorrisClientFactory
 import io.github.kotlin.allfunds.networking.di.KoinInitializer
 
 /**
@@ -85,4 +86,29 @@ object SampleUsage {
             onError(e)
         }
     }
+
+    // Wires the client stack once, on first use, without Koin
+    private val clientFactory = ChuckNorrisClientFactory()
+
+    /**
+     * Example of how to use clients from a [ChuckNorrisClientFactory]
+     *
+     * Factory clients share one API and set of use cases, so creating one per call is cheap.
+     *
+     * @param onJokeReceived Callback for when a joke is received
+     * @param onError Callback for when an error occurs
+     */
+    suspend fun getRandomJokeWithoutKoin(
+        onJokeReceived: (String) -> Unit,
+        onError: (Throwable) -> Unit
+    ) {
+        val client = clientFactory.create()
+
+        try {
+            val joke = client.getRandomJoke()
+            onJokeReceived(joke.value)
+        } catch (e: Throwable) {
+            onError(e)
+        }
+    }
 }
\ No newline at end of file
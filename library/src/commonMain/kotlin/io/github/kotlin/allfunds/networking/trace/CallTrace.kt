@@ -0,0 +1,65 @@
+package io.github.kotlin.allfunds.networking.trace
+
+import kotlinx.serialization.SerialName
+import kotlinx.serialization.Serializable
+import kotlinx.serialization.json.Json
+
+/**
+ * Public call of [io.github.kotlin.allfunds.networking.ChuckNorrisClient]
+ */
+enum class ClientOperation {
+    RANDOM,
+    RANDOM_BY_CATEGORY,
+    CATEGORIES,
+    SEARCH,
+    SEARCH_BATCH
+}
+
+/**
+ * One recorded client call
+ *
+ * @property offsetMicros Time since the start of the trace when the call was issued
+ * @property operation Which client method was called
+ * @property argument Category or search query, when the operation takes one; the queries of a
+ * [ClientOperation.SEARCH_BATCH], one per line
+ */
+@Serializable
+data class TraceEvent(
+    @SerialName("t")
+    val offsetMicros: Long,
+
+    @SerialName("op")
+    val operation: ClientOperation,
+
+    @SerialName("arg")
+    val argument: String? = null
+)
+
+/**
+ * Sequence and timing of client calls, as issued by the application
+ *
+ * Stored as JSON lines, one event per line.
+ */
+data class CallTrace(val events: List<TraceEvent>) {
+
+    /**
+     * Encode the trace as JSON lines
+     */
+    fun encode(): String = events.joinToString(separator = "\n") {
+        json.encodeToString(TraceEvent.serializer(), it)
+    }
+
+    companion object {
+        private val json = Json { ignoreUnknownKeys = true }
+
+        /**
+         * Decode a trace from JSON lines
+         */
+        fun decode(text: String): CallTrace = CallTrace(
+            text.lineSequence()
+                .filter { it.isNotBlank() }
+                .map { json.decodeFromString(TraceEvent.serializer(), it) }
+                .toList()
+        )
+    }
+}
@@ -0,0 +1,61 @@
+package io.github.kotlin.allfunds.networking.trace
+
+import kotlin.concurrent.atomics.AtomicInt
+import kotlin.concurrent.atomics.ExperimentalAtomicApi
+import kotlin.time.TimeSource
+
+/**
+ * Low-overhead recorder of client calls
+ *
+ * Recording claims a slot in preallocated arrays with a single atomic increment and never
+ * suspends or locks. Calls beyond [capacity] are counted in [dropped] and otherwise ignored.
+ * Take the [trace] once recording is over; slots still being written at that moment may be
+ * missing their argument.
+ *
+ * @param capacity Maximum number of calls kept
+ */
+@OptIn(ExperimentalAtomicApi::class)
+class CallTraceRecorder(val capacity: Int = DEFAULT_CAPACITY) {
+    private val start = TimeSource.Monotonic.markNow()
+    private val offsets = LongArray(capacity)
+    private val operations = arrayOfNulls<ClientOperation>(capacity)
+    private val arguments = arrayOfNulls<String>(capacity)
+    private val next = AtomicInt(0)
+
+    /**
+     * Number of calls that did not fit in the recorder
+     */
+    val dropped: Int
+        get() = (next.load() - capacity).coerceAtLeast(0)
+
+    /**
+     * Record one call
+     * @param operation Client method called
+     * @param argument Category or query of the call
+     */
+    fun record(operation: ClientOperation, argument: String? = null) {
+        val slot = next.fetchAndAdd(1)
+        if (slot >= capacity) return
+        offsets[slot] = start.elapsedNow().inWholeMicroseconds
+        arguments[slot] = argument
+        operations[slot] = operation
+    }
+
+    /**
+     * Trace of the calls recorded so far, ordered by time
+     */
+    fun trace(): CallTrace {
+        val size = next.load().coerceAtMost(capacity)
+        val events = ArrayList<TraceEvent>(size)
+        for (slot in 0 until size) {
+            val operation = operations[slot] ?: continue
+            events += TraceEvent(offsets[slot], operation, arguments[slot])
+        }
+        events.sortBy { it.offsetMicros }
+        return CallTrace(events)
+    }
+
+    companion object {
+        const val DEFAULT_CAPACITY = 10_000
+    }
+}
@@ -0,0 +1,61 @@
+package io.github.kotlin.allfunds.networking
+
+import io.github.kotlin.allfunds.networking.data.remote.ChuckNorrisApi
+import io.github.kotlin.allfunds.networking.data.remote.ChuckNorrisApiConfig
+import io.github.kotlin.allfunds.networking.data.remote.dto.JokeDto
+import io.github.kotlin.allfunds.networking.data.remote.dto.SearchResponseDto
+import io.github.kotlin.allfunds.networking.loadtest.ChuckNorrisStubServer
+import kotlinx.coroutines.test.runTest
+import org.koin.mp.KoinPlatformTools
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertNull
+import kotlin.time.Duration
+
+class ChuckNorrisClientFactoryTest {
+
+    private fun factory(server: ChuckNorrisStubServer) =
+        ChuckNorrisClientFactory(ChuckNorrisApiConfig(baseUrl = server.baseUrl, engineFactory = server.engineFactory()))
+
+    @Test
+    fun factoriesAreIsolatedAndNeedNoGlobalKoin() = runTest {
+        val first = ChuckNorrisStubServer()
+        val second = ChuckNorrisStubServer()
+        val firstFactory = factory(first)
+        val secondFactory = factory(second)
+
+        repeat(3) { firstFactory.create().getRandomJoke() }
+        secondFactory.create().getCategories()
+
+        assertEquals(3, first.totalRequests)
+        assertEquals(1, second.totalRequests)
+        assertNull(KoinPlatformTools.defaultContext().getOrNull())
+    }
+
+    @Test
+    fun clientsShareOneApi() = runTest {
+        val api = CountingApi()
+        val factory = ChuckNorrisClientFactory(api)
+
+        repeat(5) { factory.create().getCategories() }
+        val report = factory.create().warmUp()
+
+        assertEquals(5, api.categoryCalls)
+        assertEquals(Duration.ZERO, report.koinStartup)
+    }
+
+    private class CountingApi : ChuckNorrisApi {
+        var categoryCalls = 0
+
+        override suspend fun getRandomJoke(): JokeDto = throw UnsupportedOperationException()
+
+        override suspend fun getRandomJokeByCategory(category: String): JokeDto = throw UnsupportedOperationException()
+
+        override suspend fun getCategories(): List<String> {
+            categoryCalls++
+            return listOf("dev")
+        }
+
+        override suspend fun searchJokes(query: String): SearchResponseDto = SearchResponseDto(0, emptyList())
+    }
+}
@@ -0,0 +1,92 @@
+package io.github.kotlin.allfunds.networking
+
+import io.github.kotlin.allfunds.networking.data.remote.ChuckNorrisApi
+import io.github.kotlin.allfunds.networking.data.remote.ChuckNorrisApiConfig
+import io.github.kotlin.allfunds.networking.di.KoinInitializer
+import io.github.kotlin.allfunds.networking.loadtest.ChuckNorrisStubServer
+import io.github.kotlin.allfunds.networking.loadtest.LatencyDistribution
+import io.github.kotlin.allfunds.networking.loadtest.StubServerConfig
+import kotlinx.coroutines.Dispatchers
+import kotlinx.coroutines.async
+import kotlinx.coroutines.delay
+import kotlinx.coroutines.test.runTest
+import kotlinx.coroutines.withContext
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertFails
+import kotlin.test.assertTrue
+import kotlin.time.Duration.Companion.milliseconds
+import kotlin.time.Duration.Companion.seconds
+import kotlin.time.TimeSource
+
+class ClientLifecycleTest {
+
+    private fun config(server: ChuckNorrisStubServer) =
+        ChuckNorrisApiConfig(baseUrl = server.baseUrl, engineFactory = server.engineFactory())
+
+    @Test
+    fun closedClientRejectsCalls() = runTest {
+        val server = ChuckNorrisStubServer()
+        val client = ChuckNorrisClient(config(server))
+
+        client.use { it.getCategories() }
+
+        assertFails { client.getCategories() }
+        assertEquals(1, server.totalRequests)
+    }
+
+    @Test
+    fun closeLetsCallsInFlightComplete() = runTest {
+        val server = ChuckNorrisStubServer(StubServerConfig(randomLatency = LatencyDistribution.Fixed(200.milliseconds)))
+        val client = ChuckNorrisClient(config(server))
+
+        val joke = withContext(Dispatchers.Default) {
+            val call = async { client.getRandomJoke() }
+            while (server.totalRequests == 0) delay(5)
+            client.close()
+            call.await()
+        }
+
+        assertTrue(joke.id.isNotEmpty())
+    }
+
+    @Test
+    fun shutdownCancelsCallsPastTheGracePeriod() = runTest {
+        val server = ChuckNorrisStubServer(StubServerConfig(randomLatency = LatencyDistribution.Fixed(30.seconds)))
+        val client = ChuckNorrisClient(config(server))
+
+        val elapsed = withContext(Dispatchers.Default) {
+            val start = TimeSource.Monotonic.markNow()
+            val call = async { runCatching { client.getRandomJoke() } }
+            while (server.totalRequests == 0) delay(5)
+            client.shutdown(gracePeriod = 50.milliseconds)
+            assertTrue(call.await().isFailure)
+            start.elapsedNow()
+        }
+
+        assertTrue(elapsed < 5.seconds, "elapsed: $elapsed")
+    }
+
+    @Test
+    fun closingAFactoryHandleKeepsTheSharedApiOpen() = runTest {
+        val server = ChuckNorrisStubServer()
+        ChuckNorrisClientFactory(config(server)).use { factory ->
+            factory.create().use { it.getCategories() }
+
+            factory.create().getCategories()
+        }
+
+        assertEquals(2, server.totalRequests)
+    }
+
+    @Test
+    fun closingTheLibraryContainerClosesItsApi() = runTest {
+        val api = KoinInitializer.init().koin.get<ChuckNorrisApi>()
+
+        KoinInitializer.close()
+
+        // Fails before reaching the network
+        assertFails { api.getCategories() }
+        assertTrue(KoinInitializer.init().koin.get<ChuckNorrisApi>() !== api)
+    }
+}
@@ -0,0 +1,101 @@
+package io.github.kotlin.allfunds.networking
+
+import io.github.kotlin.allfunds.networking.data.remote.ChuckNorrisApiConfig
+import io.github.kotlin.allfunds.networking.loadtest.ChuckNorrisStubServer
+import io.github.kotlin.allfunds.networking.loadtest.LatencyDistribution
+import io.github.kotlin.allfunds.networking.loadtest.StubServerConfig
+import io.ktor.client.engine.config
+import io.ktor.client.engine.mock.MockEngine
+import kotlinx.coroutines.Dispatchers
+import kotlinx.coroutines.async
+import kotlinx.coroutines.awaitAll
+import kotlinx.coroutines.delay
+import kotlinx.coroutines.test.runTest
+import kotlinx.coroutines.withContext
+import kotlin.concurrent.atomics.AtomicInt
+import kotlin.concurrent.atomics.ExperimentalAtomicApi
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertFails
+import kotlin.test.assertTrue
+import kotlin.time.Duration.Companion.milliseconds
+import kotlin.time.Duration.Companion.seconds
+import kotlin.time.measureTime
+
+/**
+ * Interactive and bulk clients in one process, each bounded on its own
+ */
+@OptIn(ExperimentalAtomicApi::class)
+class IsolatedClientsTest {
+
+    /**
+     * Stub server engine that also records the highest number of concurrent requests
+     */
+    private class ConcurrencyProbe(val server: ChuckNorrisStubServer) {
+        private val running = AtomicInt(0)
+        val peak = AtomicInt(0)
+
+        fun engineFactory() = MockEngine.config {
+            addHandler { request ->
+                val now = running.incrementAndFetch()
+                while (true) {
+                    val current = peak.load()
+                    if (now <= current || peak.compareAndSet(current, now)) break
+                }
+                try {
+                    with(server) { handle(request) }
+                } finally {
+                    running.decrementAndFetch()
+                }
+            }
+        }
+    }
+
+    @Test
+    fun bulkTrafficIsBoundedAndCannotStarveInteractiveCalls() = runTest {
+        val bulkProbe = ConcurrencyProbe(
+            ChuckNorrisStubServer(StubServerConfig(searchLatency = LatencyDistribution.Fixed(100.milliseconds)))
+        )
+        val interactiveServer = ChuckNorrisStubServer()
+        val bulk = ChuckNorrisClient(
+            ChuckNorrisApiConfig(
+                baseUrl = ChuckNorrisStubServer.BASE_URL,
+                engineFactory = bulkProbe.engineFactory(),
+                maxConcurrentRequests = 2
+            )
+        )
+        val interactive = ChuckNorrisClient(
+            ChuckNorrisApiConfig(baseUrl = interactiveServer.baseUrl, engineFactory = interactiveServer.engineFactory())
+        )
+
+        withContext(Dispatchers.Default) {
+            val backlog = List(20) { async { bulk.searchJokes("kick") } }
+            delay(50)
+            val interactiveLatency = measureTime { interactive.getRandomJoke() }
+            backlog.awaitAll()
+
+            assertTrue(interactiveLatency < 100.milliseconds, "interactive call took $interactiveLatency")
+        }
+
+        assertEquals(2, bulkProbe.peak.load())
+        bulk.close()
+        interactive.close()
+    }
+
+    @Test
+    fun requestTimeoutIsPerInstance() = runTest {
+        val server = ChuckNorrisStubServer(StubServerConfig(randomLatency = LatencyDistribution.Fixed(2.seconds)))
+        val impatient = ChuckNorrisClient(
+            ChuckNorrisApiConfig(
+                baseUrl = server.baseUrl,
+                engineFactory = server.engineFactory(),
+                requestTimeout = 100.milliseconds
+            )
+        )
+
+        withContext(Dispatchers.Default) {
+            assertFails { impatient.getRandomJoke() }
+        }
+        impatient.close()
+    }
+}
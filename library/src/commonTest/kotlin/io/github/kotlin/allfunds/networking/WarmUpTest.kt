@@ -0,0 +1,48 @@
+package io.github.kotlin.allfunds.networking
+
+import io.github.kotlin.allfunds.networking.data.remote.ChuckNorrisApiConfig
+import io.github.kotlin.allfunds.networking.data.remote.ChuckNorrisApiImpl
+import io.github.kotlin.allfunds.networking.loadtest.ChuckNorrisStubServer
+import io.github.kotlin.allfunds.networking.loadtest.stubClient
+import io.ktor.client.engine.config
+import io.ktor.client.engine.mock.MockEngine
+import kotlinx.coroutines.test.runTest
+import org.koin.core.context.stopKoin
+import kotlin.test.AfterTest
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertFalse
+import kotlin.test.assertTrue
+
+class WarmUpTest {
+
+    @AfterTest
+    fun tearDown() {
+        stopKoin()
+    }
+
+    @Test
+    fun warmUpOpensConnectionsAndReportsEveryPhase() = runTest {
+        val server = ChuckNorrisStubServer()
+        val client = stubClient(server)
+
+        val report = client.warmUp(connections = 2)
+
+        assertTrue(report.connected)
+        assertEquals(2, server.requestCounts[ChuckNorrisStubServer.CATEGORIES_PATH])
+        assertTrue(report.total >= report.serializers + report.connections)
+
+        client.getRandomJoke()
+        assertEquals(1, server.requestCounts[ChuckNorrisStubServer.RANDOM_PATH])
+    }
+
+    @Test
+    fun warmUpReportsUnreachableHostWithoutThrowing() = runTest {
+        val offline = MockEngine.config { addHandler { throw IllegalStateException("offline") } }
+        val api = ChuckNorrisApiImpl(ChuckNorrisApiConfig(baseUrl = ChuckNorrisStubServer.BASE_URL, engineFactory = offline))
+
+        val report = api.warmUp(connections = 1)
+
+        assertFalse(report.connected)
+    }
+}
@@ -0,0 +1,47 @@
+package io.github.kotlin.allfunds.networking.benchmark
+
+import kotlinx.io.buffered
+import kotlinx.io.files.Path
+import kotlinx.io.files.SystemFileSystem
+import kotlinx.io.files.SystemTemporaryDirectory
+import kotlinx.io.writeString
+import kotlinx.serialization.json.JsonObject
+import kotlinx.serialization.json.JsonPrimitive
+import kotlin.time.Clock
+import kotlin.time.ExperimentalTime
+
+/**
+ * Append-only history of benchmark results
+ *
+ * Every result is appended as one JSON line to `build/benchmarks/<name>.jsonl` when running
+ * from the module directory, or to the temporary directory otherwise, so results can be
+ * compared across commits. Nothing is printed, so test output stays quiet.
+ */
+object BenchmarkLog {
+
+    /**
+     * Append one result
+     * @param name Benchmark name, also used as the file name
+     * @param metrics Measured values
+     */
+    @OptIn(ExperimentalTime::class)
+    fun append(name: String, metrics: Map<String, Number>) {
+        val line = JsonObject(
+            mapOf(
+                "benchmark" to JsonPrimitive(name),
+                "platform" to JsonPrimitive(platformName),
+                "timestamp" to JsonPrimitive(Clock.System.now().toString())
+            ) + metrics.mapValues { JsonPrimitive(it.value) }
+        ).toString()
+        val path = Path(directory(), "$name.jsonl")
+        SystemFileSystem.sink(path, append = true).buffered().use { it.writeString(line + "\n") }
+    }
+
+    private fun directory(): Path {
+        val build = Path("build")
+        if (!SystemFileSystem.exists(build)) return SystemTemporaryDirectory
+        val benchmarks = Path(build, "benchmarks")
+        SystemFileSystem.createDirectories(benchmarks)
+        return benchmarks
+    }
+}
@@ -0,0 +1,49 @@
+package io.github.kotlin.allfunds.networking.benchmark
+
+import io.github.kotlin.allfunds.networking.ChuckNorrisClient
+import io.github.kotlin.allfunds.networking.data.remote.ChuckNorrisApi
+import io.github.kotlin.allfunds.networking.di.KoinInitializer
+import io.github.kotlin.allfunds.networking.domain.usecase.SearchJokesUseCase
+import kotlin.test.Test
+import kotlin.test.assertSame
+import kotlin.time.measureTime
+import kotlin.time.measureTimedValue
+
+/**
+ * Time from process start to the first usable client, without network access
+ *
+ * Only the first run in a process is truly cold, so `containerWasWarm` records whether another
+ * test already created the library container. Results are appended to the `cold-start`
+ * [BenchmarkLog].
+ */
+class ColdStartBenchmark {
+
+    @Test
+    fun timeToFirstClient() {
+        val containerWasWarm = KoinInitializer.isInitialized()
+
+        val (client, construction) = measureTimedValue { ChuckNorrisClient() }
+        val firstResolution = measureTime { client.getKoin().get<SearchJokesUseCase>() }
+        val apiResolution = measureTime { client.getKoin().get<ChuckNorrisApi>() }
+        val warmConstruction = measureTime {
+            repeat(WARM_CLIENTS) { ChuckNorrisClient().getKoin() }
+        } / WARM_CLIENTS
+
+        BenchmarkLog.append(
+            "cold-start",
+            mapOf(
+                "containerWasWarm" to if (containerWasWarm) 1 else 0,
+                "constructionMicros" to construction.inWholeMicroseconds,
+                "firstResolutionMicros" to firstResolution.inWholeMicroseconds,
+                "apiResolutionMicros" to apiResolution.inWholeMicroseconds,
+                "warmClientMicros" to warmConstruction.inWholeMicroseconds
+            )
+        )
+
+        assertSame(KoinInitializer.init().koin, client.getKoin())
+    }
+
+    private companion object {
+        const val WARM_CLIENTS = 100
+    }
+}
@@ -0,0 +1,11 @@
+package io.github.kotlin.allfunds.networking.benchmark
+
+/**
+ * Name of the platform running the benchmark
+ */
+expect val platformName: String
+
+/**
+ * Force a full garbage collection and return the bytes still occupied by live objects
+ */
+expect fun retainedHeapBytes(): Long
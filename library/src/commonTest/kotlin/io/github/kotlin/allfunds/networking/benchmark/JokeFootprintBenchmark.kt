@@ -0,0 +1,120 @@
+package io.github.kotlin.allfunds.networking.benchmark
+
+import io.github.kotlin.allfunds.networking.data.remote.decode.JokeJsonDecoder
+import io.github.kotlin.allfunds.networking.data.remote.dto.SearchResponseDto
+import io.github.kotlin.allfunds.networking.domain.model.Joke
+import io.github.kotlin.allfunds.networking.loadtest.JokeFixtures
+import kotlinx.serialization.json.Json
+import kotlin.random.Random
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertTrue
+
+/**
+ * Retained heap of decoded search results, per joke
+ *
+ * Decodes an N-joke search response with the same JSON configuration as the API client, keeps
+ * the results alive and measures the heap they retain after a full collection. Results are
+ * appended to the `joke-footprint` [BenchmarkLog].
+ */
+class JokeFootprintBenchmark {
+
+    private val json = Json {
+        ignoreUnknownKeys = true
+        coerceInputValues = true
+        isLenient = true
+    }
+
+    @Test
+    fun retainedHeapPerJoke() {
+        val payload = JokeFixtures.encode(JokeFixtures.searchResponse(Random(1), JOKE_COUNT))
+
+        val baseline = retainedHeapBytes()
+        val responses = mutableListOf(json.decodeFromString(SearchResponseDto.serializer(), payload))
+        val withDtos = retainedHeapBytes()
+        val jokes: List<Joke> = responses.single().toDomain()
+        responses.clear()
+        val withJokes = retainedHeapBytes()
+
+        val dtoBytesPerJoke = (withDtos - baseline) / JOKE_COUNT
+        val jokeBytesPerJoke = (withJokes - baseline) / JOKE_COUNT
+        val distinctCategoryInstances = jokes.distinctCategoryInstances()
+        val categoryReferences = jokes.sumOf { it.categories.size }
+        BenchmarkLog.append(
+            "joke-footprint",
+            mapOf(
+                "jokes" to JOKE_COUNT,
+                "dtoBytesPerJoke" to dtoBytesPerJoke,
+                "jokeBytesPerJoke" to jokeBytesPerJoke,
+                "distinctCategoryInstances" to distinctCategoryInstances,
+                "categoryReferences" to categoryReferences
+            )
+        )
+
+        // Reading the results after the last probe keeps them reachable during measurement
+        assertEquals(JOKE_COUNT, jokes.size)
+        // The joke keeps the text but derives the url and shares the category names
+        assertTrue(jokeBytesPerJoke in 1 until dtoBytesPerJoke, "joke $jokeBytesPerJoke B, dto $dtoBytesPerJoke B")
+        assertTrue(categoryReferences > distinctCategoryInstances)
+        assertTrue(distinctCategoryInstances <= JokeFixtures.categories.size, "category instances: $distinctCategoryInstances")
+    }
+
+    @Test
+    fun retainedHeapPerLazyTextJoke() {
+        val payload = JokeFixtures.encode(JokeFixtures.searchResponse(Random(1), JOKE_COUNT, VALUE_LENGTH)).encodeToByteArray()
+
+        val baseline = retainedHeapBytes()
+        val jokes = JokeJsonDecoder.decodeSearch(payload, lazyText = true).jokes
+        val withLazyJokes = retainedHeapBytes()
+        val prefixChars = jokes.sumOf { it.valuePrefix(PREFIX_CHARS).length }
+        val withPrefixes = retainedHeapBytes()
+        val lazyJokeBytesPerJoke = (withLazyJokes - baseline) / JOKE_COUNT
+        val afterPrefixBytesPerJoke = (withPrefixes - baseline) / JOKE_COUNT
+
+        BenchmarkLog.append(
+            "joke-footprint-lazy-text",
+            mapOf(
+                "jokes" to JOKE_COUNT,
+                "lazyJokeBytesPerJoke" to lazyJokeBytesPerJoke,
+                "afterPrefixBytesPerJoke" to afterPrefixBytesPerJoke
+            )
+        )
+
+        // Reading prefixes must not decode and retain the full texts
+        assertEquals(JOKE_COUNT * PREFIX_CHARS, prefixChars)
+        assertEquals(JOKE_COUNT, jokes.size)
+        assertTrue(jokes.none { it.isValueDecoded })
+        assertTrue(lazyJokeBytesPerJoke > 0, "lazy joke $lazyJokeBytesPerJoke B")
+        // A retained decoded text would take at least a byte per character
+        assertTrue(
+            afterPrefixBytesPerJoke - lazyJokeBytesPerJoke < VALUE_LENGTH,
+            "lazy joke $lazyJokeBytesPerJoke B, after prefixes $afterPrefixBytesPerJoke B"
+        )
+    }
+
+    /**
+     * Number of separate String instances backing the category names, as opposed to their values
+     */
+    private fun List<Joke>.distinctCategoryInstances(): Int {
+        val instances = HashSet<Identity>()
+        for (joke in this) {
+            for (category in joke.categories) instances += Identity(category)
+        }
+        return instances.size
+    }
+
+    /**
+     * Set key comparing [value] by reference
+     */
+    private class Identity(val value: Any) {
+        override fun equals(other: Any?): Boolean = other is Identity && other.value === value
+
+        override fun hashCode(): Int = value.hashCode()
+    }
+
+    private companion object {
+        const val JOKE_COUNT = 20_000
+        const val PREFIX_CHARS = 40
+        const val VALUE_LENGTH = 120
+    }
+}
@@ -0,0 +1,98 @@
+package io.github.kotlin.allfunds.networking.data.remote
+
+import io.github.kotlin.allfunds.networking.data.remote.decode.ByteBufferPool
+import io.github.kotlin.allfunds.networking.data.remote.decode.JokeJsonDecoder
+import io.github.kotlin.allfunds.networking.loadtest.ChuckNorrisStubServer
+import io.github.kotlin.allfunds.networking.loadtest.JokeFixtures
+import io.github.kotlin.allfunds.networking.loadtest.StubServerConfig
+import kotlinx.coroutines.CoroutineDispatcher
+import kotlinx.coroutines.Dispatchers
+import kotlinx.coroutines.launch
+import kotlinx.coroutines.test.runTest
+import kotlinx.coroutines.yield
+import kotlin.concurrent.atomics.AtomicInt
+import kotlin.concurrent.atomics.ExperimentalAtomicApi
+import kotlin.concurrent.atomics.incrementAndFetch
+import kotlin.coroutines.CoroutineContext
+import kotlin.random.Random
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertTrue
+
+@OptIn(ExperimentalAtomicApi::class)
+class DecodeDispatcherTest {
+
+    private val server = ChuckNorrisStubServer(StubServerConfig(searchResultCount = 30))
+
+    /**
+     * Dispatcher that counts the blocks sent to it and runs them on [Dispatchers.Default]
+     */
+    private class CountingDispatcher : CoroutineDispatcher() {
+        val dispatches = AtomicInt(0)
+
+        override fun dispatch(context: CoroutineContext, block: Runnable) {
+            dispatches.incrementAndFetch()
+            Dispatchers.Default.dispatch(context, block)
+        }
+    }
+
+    private fun api(dispatcher: CoroutineDispatcher?, listener: ApiListener? = null, pool: ByteBufferPool? = null) =
+        ChuckNorrisApiImpl(
+            ChuckNorrisApiConfig(
+                baseUrl = server.baseUrl,
+                engineFactory = server.engineFactory(),
+                bufferPool = pool,
+                decodeDispatcher = dispatcher,
+                listener = listener
+            )
+        )
+
+    @Test
+    fun responsesAreDecodedOnTheDecodeDispatcher() = runTest {
+        val expected = api(dispatcher = null).searchJokeList("kick")
+
+        for (pool in listOf(null, ByteBufferPool())) {
+            val dispatcher = CountingDispatcher()
+            val api = api(dispatcher, pool = pool)
+
+            assertEquals(expected, api.searchJokeList("kick"))
+            assertEquals(1, dispatcher.dispatches.load())
+
+            api.getRandomJoke()
+            api.getCategories()
+            assertEquals(3, dispatcher.dispatches.load())
+        }
+    }
+
+    @Test
+    fun listenerReportsNetworkAndDecodeTimeSeparately() = runTest {
+        val timings = mutableListOf<CallTiming>()
+        val api = api(ChuckNorrisApiConfig.DEFAULT_DECODE_DISPATCHER, listener = { timings += it })
+
+        api.getRandomJoke()
+        api.getCategories()
+        api.searchJokes("kick")
+        api.searchJokeList("kick")
+
+        assertEquals(listOf("/random", "/categories", "/search", "/search"), timings.map { it.path })
+        assertTrue(timings.all { it.responseBytes > 0 && it.decode.isPositive() })
+    }
+
+    @Test
+    fun largePayloadDecodeYieldsBetweenChunks() = runTest {
+        val payload = JokeFixtures.encode(JokeFixtures.searchResponse(Random(7), count = 200)).encodeToByteArray()
+        var otherSteps = 0
+        val other = launch {
+            while (true) {
+                otherSteps++
+                yield()
+            }
+        }
+
+        val result = JokeJsonDecoder.decodeSearchCooperatively(payload, chunkSize = 20)
+        other.cancel()
+
+        assertEquals(JokeJsonDecoder.decodeSearch(payload), result)
+        assertTrue(otherSteps >= 200 / 20 - 1, "decode yielded $otherSteps times")
+    }
+}
@@ -0,0 +1,68 @@
+package io.github.kotlin.allfunds.networking.data.remote
+
+import io.github.kotlin.allfunds.networking.data.remote.decode.ByteBufferPool
+import io.github.kotlin.allfunds.networking.domain.model.Joke
+import io.github.kotlin.allfunds.networking.domain.model.SearchProjection
+import io.github.kotlin.allfunds.networking.loadtest.ChuckNorrisStubServer
+import io.github.kotlin.allfunds.networking.loadtest.StubServerConfig
+import kotlinx.coroutines.test.runTest
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertSame
+import kotlin.test.assertTrue
+
+class SearchProjectionTest {
+
+    private val server = ChuckNorrisStubServer(StubServerConfig(searchResultCount = 30))
+
+    private fun api(pool: ByteBufferPool? = null, textDecoding: TextDecoding = TextDecoding.EAGER) =
+        ChuckNorrisApiImpl(
+            ChuckNorrisApiConfig(
+                baseUrl = server.baseUrl,
+                engineFactory = server.engineFactory(),
+                bufferPool = pool,
+                textDecoding = textDecoding
+            )
+        )
+
+    @Test
+    fun projectionsKeepRequestedFields() = runTest {
+        val full = api().searchJokes("kick")
+
+        for (pool in listOf(null, ByteBufferPool())) {
+            val api = api(pool)
+            assertEquals(full.result.map { it.toDomain() }, api.searchJokes("kick", SearchProjection.FULL).jokes)
+
+            val withText = api.searchJokes("kick", SearchProjection.IDS_AND_TEXT)
+            assertEquals(full.result.map { it.id to it.value }, withText.jokes.map { it.id to it.value })
+            assertTrue(withText.jokes.all { it.categories.isEmpty() })
+
+            val ids = api.searchJokes("kick", SearchProjection.IDS)
+            assertEquals(full.result.map { it.id }, ids.jokes.map { it.id })
+        }
+    }
+
+    @Test
+    fun countOnlyReturnsTotalWithoutJokes() = runTest {
+        for (pool in listOf(null, ByteBufferPool(bufferSize = 64))) {
+            val result = api(pool).searchJokes("kick", SearchProjection.COUNT_ONLY)
+
+            assertEquals(30, result.total)
+            assertTrue(result.jokes.isEmpty())
+        }
+    }
+
+    @Test
+    fun knownJokesAreReturnedAsTheKnownInstances() = runTest {
+        val full = api().searchJokeList("kick")
+        val held = full.take(3).map { Joke(it.id, "Held", it.url, it.categories) }.associateBy { it.id }
+
+        for (textDecoding in TextDecoding.entries) {
+            val jokes = api(ByteBufferPool(), textDecoding).searchJokeList("kick") { id -> held[id] }
+
+            assertEquals(full.map { it.id }, jokes.map { it.id })
+            jokes.take(3).forEach { assertSame(held.getValue(it.id), it) }
+            assertEquals(full.drop(3), jokes.drop(3))
+        }
+    }
+}
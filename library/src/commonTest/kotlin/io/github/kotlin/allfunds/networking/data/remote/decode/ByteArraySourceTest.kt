@@ -0,0 +1,25 @@
+package io.github.kotlin.allfunds.networking.data.remote.decode
+
+import io.github.kotlin.allfunds.networking.data.remote.dto.SearchResponseDto
+import io.github.kotlin.allfunds.networking.loadtest.JokeFixtures
+import kotlinx.io.buffered
+import kotlinx.serialization.json.Json
+import kotlinx.serialization.json.io.decodeFromSource
+import kotlin.random.Random
+import kotlin.test.Test
+import kotlin.test.assertEquals
+
+class ByteArraySourceTest {
+
+    @Test
+    fun decodesOnlyTheGivenRangeOfTheBuffer() {
+        // Several segments long, with stale bytes after it as in a reused pooled buffer
+        val expected = JokeFixtures.searchResponse(Random(3), 200)
+        val body = JokeFixtures.encode(expected).encodeToByteArray()
+        val buffer = body + "garbage".encodeToByteArray()
+
+        val decoded = Json.decodeFromSource(SearchResponseDto.serializer(), ByteArraySource(buffer, 0, body.size).buffered())
+
+        assertEquals(expected, decoded)
+    }
+}
@@ -0,0 +1,70 @@
+package io.github.kotlin.allfunds.networking.data.remote.decode
+
+import io.github.kotlin.allfunds.networking.data.remote.ChuckNorrisApiConfig
+import io.github.kotlin.allfunds.networking.data.remote.ChuckNorrisApiImpl
+import io.github.kotlin.allfunds.networking.data.remote.TextDecoding
+import io.github.kotlin.allfunds.networking.loadtest.ChuckNorrisStubServer
+import io.github.kotlin.allfunds.networking.loadtest.StubServerConfig
+import kotlinx.coroutines.test.runTest
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertNotSame
+import kotlin.test.assertSame
+
+class ByteBufferPoolTest {
+
+    @Test
+    fun releasedBuffersAreReused() {
+        val pool = ByteBufferPool(bufferSize = 64, maxRetainedSize = 256, capacity = 2)
+
+        val first = pool.acquire()
+        pool.release(first)
+
+        assertSame(first, pool.acquire(32))
+        assertEquals(1, pool.allocations)
+        assertEquals(1, pool.reuses)
+    }
+
+    @Test
+    fun oversizedBuffersAreNotRetained() {
+        val pool = ByteBufferPool(bufferSize = 64, maxRetainedSize = 256, capacity = 2)
+
+        val large = pool.acquire(1024)
+        pool.release(large)
+
+        assertNotSame(large, pool.acquire(1024))
+        assertEquals(2, pool.allocations)
+    }
+
+    @Test
+    fun searchDecodesFromPooledBuffers() = runTest {
+        // Buffers start smaller than a response, so the receive path has to grow them
+        val pool = ByteBufferPool(bufferSize = 1024)
+        val server = ChuckNorrisStubServer(StubServerConfig(searchResultCount = 40))
+        val plain = ChuckNorrisApiImpl(
+            ChuckNorrisApiConfig(baseUrl = server.baseUrl, engineFactory = server.engineFactory())
+        )
+        val pooled = ChuckNorrisApiImpl(
+            ChuckNorrisApiConfig(
+                baseUrl = server.baseUrl,
+                engineFactory = server.engineFactory(),
+                textDecoding = TextDecoding.LAZY,
+                bufferPool = pool
+            )
+        )
+
+        val expected = plain.searchJokeList("kick")
+        assertEquals(expected, pooled.searchJokeList("kick"))
+        val warmAllocations = pool.allocations
+        repeat(CALLS) {
+            assertEquals(expected, pooled.searchJokeList("kick"))
+        }
+
+        assertEquals(warmAllocations, pool.allocations)
+        assertEquals(CALLS, pool.reuses)
+    }
+
+    private companion object {
+        const val CALLS = 20
+    }
+}
@@ -0,0 +1,129 @@
+package io.github.kotlin.allfunds.networking.data.remote.decode
+
+import io.github.kotlin.allfunds.networking.data.remote.dto.SearchResponseDto
+import io.github.kotlin.allfunds.networking.domain.model.Joke
+import io.github.kotlin.allfunds.networking.domain.model.SearchProjection
+import io.github.kotlin.allfunds.networking.loadtest.JokeFixtures
+import kotlinx.serialization.SerializationException
+import kotlinx.serialization.json.Json
+import kotlin.random.Random
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertFailsWith
+import kotlin.test.assertNull
+import kotlin.test.assertSame
+import kotlin.test.assertTrue
+
+class JokeJsonDecoderTest {
+
+    private val json = Json {
+        ignoreUnknownKeys = true
+        coerceInputValues = true
+        isLenient = true
+    }
+
+    @Test
+    fun decodesLikeKotlinxSerialization() {
+        val payload = JokeFixtures.encode(JokeFixtures.searchResponse(Random(7), 50))
+        val expected = json.decodeFromString(SearchResponseDto.serializer(), payload).toDomain()
+
+        val eager = JokeJsonDecoder.decodeSearch(payload.encodeToByteArray())
+        val lazy = JokeJsonDecoder.decodeSearch(payload.encodeToByteArray(), lazyText = true)
+
+        assertEquals(50, eager.total)
+        assertEquals(expected, eager.jokes)
+        assertEquals(expected, lazy.jokes)
+    }
+
+    @Test
+    fun lazyTextAnswersLengthAndPrefixWithoutDecoding() {
+        val payload = """{"total":1,"result":[{"categories":[],"id":"ad7wv_-nT3akj0w0Y6XmJQ",""" +
+            """"url":"https://api.chucknorris.io/jokes/ad7wv_-nT3akj0w0Y6XmJQ","value":"Chuck Norris ☕ 🥋 wins"}]}"""
+
+        val joke = JokeJsonDecoder.decodeSearch(payload.encodeToByteArray(), lazyText = true).jokes.single()
+
+        assertEquals("Chuck Norris ☕ 🥋 wins".length, joke.valueLength)
+        assertEquals("Chuck Norris ☕", joke.valuePrefix(14))
+        // The emoji is a surrogate pair and is never split
+        assertEquals("Chuck Norris ☕ ", joke.valuePrefix(16))
+        assertEquals("Chuck Norris ☕ 🥋", joke.valuePrefix(17))
+        assertEquals("Chuck Norris ☕ 🥋 wins", joke.value)
+    }
+
+    @Test
+    fun decodesEscapedTextInLazyMode() {
+        val payload = """{"result":[{"id":"x","url":"u","value":"Say \"hi\"\né"}],"total":1}"""
+
+        val joke = JokeJsonDecoder.decodeSearch(payload.encodeToByteArray(), lazyText = true).jokes.single()
+
+        assertEquals("Say \"hi\"\né", joke.value)
+        assertEquals(joke.value.length, joke.valueLength)
+    }
+
+    @Test
+    fun knownJokesAreSkippedForTheKnownInstance() {
+        val payload = """{"total":2,"result":[{"categories":["dev"],"id":"a1","url":"u1","value":"First"},""" +
+            """{"categories":[],"id":"a2","url":"u2","value":"Second"}]}"""
+        val known = Joke("a1", "Held", "u1", listOf("dev"))
+
+        listOf(false, true).forEach { lazyText ->
+            val jokes = JokeJsonDecoder.decodeSearch(payload.encodeToByteArray(), lazyText = lazyText) { id ->
+                known.takeIf { id == it.id }
+            }.jokes
+
+            assertSame(known, jokes[0])
+            assertEquals("Second", jokes[1].value)
+        }
+    }
+
+    @Test
+    fun skipsUnknownFieldsAndNulls() {
+        val payload = """{"total":1,"extra":{"a":[1,true,null]},"result":[{"id":"x","icon_url":null,""" +
+            """"categories":null,"value":"v","url":"u","created_at":"2020"}]}"""
+
+        val joke = JokeJsonDecoder.decodeSearch(payload.encodeToByteArray()).jokes.single()
+
+        assertEquals("v", joke.value)
+        assertEquals(emptyList(), joke.categories)
+    }
+
+    @Test
+    fun rejectsMalformedJson() {
+        assertFailsWith<SerializationException> {
+            JokeJsonDecoder.decodeSearch("""{"total":1,"result":[{"id":"x"""".encodeToByteArray())
+        }
+    }
+
+    @Test
+    fun idsProjectionSkipsTextAndCategories() {
+        val payload = JokeFixtures.encode(JokeFixtures.searchResponse(Random(7), 5))
+        val expected = json.decodeFromString(SearchResponseDto.serializer(), payload)
+
+        val result = JokeJsonDecoder.decodeSearch(payload.encodeToByteArray(), projection = SearchProjection.IDS)
+
+        assertEquals(expected.result.map { it.id }, result.jokes.map { it.id })
+        assertEquals(expected.result.map { it.url }, result.jokes.map { it.url })
+        assertTrue(result.jokes.all { it.value.isEmpty() && it.categories.isEmpty() })
+    }
+
+    @Test
+    fun countOnlyStopsAfterTotal() {
+        // Everything after total is garbage, so reading past it would fail
+        val payload = """{"total":1234,"result":[{"id": oops"""
+
+        val result = JokeJsonDecoder.decodeSearch(payload.encodeToByteArray(), projection = SearchProjection.COUNT_ONLY)
+
+        assertEquals(1234, result.total)
+        assertTrue(result.jokes.isEmpty())
+    }
+
+    @Test
+    fun totalIsReadFromPartialInput() {
+        val payload = """{"result":[{"id":"x","value":"v"}],"total":42}""".encodeToByteArray()
+
+        assertNull(JokeJsonDecoder.decodeTotal(payload, 20))
+        // The number could still continue until a delimiter arrives
+        assertNull(JokeJsonDecoder.decodeTotal(payload, payload.size - 1))
+        assertEquals(42, JokeJsonDecoder.decodeTotal(payload, payload.size))
+    }
+}
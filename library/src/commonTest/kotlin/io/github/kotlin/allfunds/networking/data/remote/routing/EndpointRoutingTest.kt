@@ -0,0 +1,165 @@
+package io.github.kotlin.allfunds.networking.data.remote.routing
+
+import io.github.kotlin.allfunds.networking.data.remote.ChuckNorrisApiConfig
+import io.github.kotlin.allfunds.networking.data.remote.ChuckNorrisApiImpl
+import io.github.kotlin.allfunds.networking.data.remote.RequestRejectedException
+import io.github.kotlin.allfunds.networking.data.remote.scheduling.AdmissionControl
+import io.ktor.client.engine.mock.MockEngine
+import io.ktor.client.engine.mock.respond
+import io.ktor.client.engine.mock.respondError
+import io.ktor.http.ContentType
+import io.ktor.http.HttpHeaders
+import io.ktor.http.HttpStatusCode
+import io.ktor.http.headersOf
+import kotlinx.coroutines.CompletableDeferred
+import kotlinx.coroutines.async
+import kotlinx.coroutines.awaitAll
+import kotlinx.coroutines.flow.MutableStateFlow
+import kotlinx.coroutines.flow.first
+import kotlinx.coroutines.flow.update
+import kotlinx.coroutines.test.runTest
+import kotlin.random.Random
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertFailsWith
+import kotlin.test.assertIs
+import kotlin.test.assertNull
+import kotlin.test.assertSame
+import kotlin.test.assertTrue
+import kotlin.time.Duration.Companion.milliseconds
+import kotlin.time.Duration.Companion.seconds
+import kotlin.time.TestTimeSource
+
+class EndpointRoutingTest {
+
+    private val urls = listOf("https://eu.local/jokes", "https://us.local/jokes", "https://ap.local/jokes")
+    private val time = TestTimeSource()
+
+    private fun selector(strategy: EndpointRouting.Strategy = EndpointRouting.Strategy.LOWEST_LATENCY) =
+        EndpointSelector(urls, EndpointRouting(mirrors = urls.drop(1), strategy = strategy), time, Random(1))
+
+    /**
+     * Complete a call started with [EndpointSelector.select], failed when [latencyMillis] is null
+     */
+    private suspend fun EndpointSelector.call(endpoint: Endpoint, latencyMillis: Int?) =
+        record(endpoint, latencyMillis?.milliseconds, failed = latencyMillis == null)
+
+    @Test
+    fun callsGoToTheFastestEndpointOnceAllAreMeasured() = runTest {
+        val selector = selector()
+        val (eu, us, ap) = selector.endpoints
+
+        // Unmeasured endpoints are tried first, in order
+        assertSame(eu, selector.select(emptySet()).also { selector.call(it!!, 80) })
+        assertSame(us, selector.select(emptySet()).also { selector.call(it!!, 20) })
+        assertSame(ap, selector.select(emptySet()).also { selector.call(it!!, 50) })
+
+        repeat(5) {
+            assertSame(us, selector.select(emptySet()).also { selector.call(it!!, 20) })
+        }
+    }
+
+    @Test
+    fun failingEndpointsAreEjectedThenProbed() = runTest {
+        val selector = selector()
+        val (eu, us, ap) = selector.endpoints
+        repeat(3) { selector.call(selector.select(emptySet())!!, 30) }
+
+        repeat(3) { selector.call(selector.select(setOf(us, ap))!!, null) }
+        assertTrue(selector.status().first().ejected)
+        assertSame(us, selector.select(emptySet())!!.also { selector.call(it, 30) })
+
+        time += 31.seconds
+        val probe = selector.select(setOf(us, ap))!!
+        assertSame(eu, probe)
+        selector.call(probe, null)
+        // Back on probation, so a single failure ejects it again
+        assertTrue(selector.status().first().ejected)
+    }
+
+    @Test
+    fun exhaustedEndpointsEndTheFailover() = runTest {
+        val selector = selector()
+        val tried = selector.endpoints.toSet()
+
+        assertNull(selector.select(tried))
+    }
+
+    @Test
+    fun powerOfTwoChoicesSpreadsLoadOverTheBetterEndpoints() = runTest {
+        val selector = selector(EndpointRouting.Strategy.POWER_OF_TWO_CHOICES)
+        val latencies = selector.endpoints.zip(listOf(20, 25, 200)).toMap()
+        for ((endpoint, latency) in latencies) {
+            selector.select(selector.endpoints.filter { it !== endpoint }.toSet())
+            selector.call(endpoint, latency)
+        }
+
+        val picks = List(300) { selector.select(emptySet())!!.also { selector.call(it, latencies.getValue(it)) } }
+
+        // The slowest endpoint loses every pair it is drawn in; the fastest wins two pairs out of three
+        assertEquals(0, picks.count { it.baseUrl == urls[2] })
+        assertTrue(picks.count { it.baseUrl == urls[1] } > 50, "us picked ${picks.count { it.baseUrl == urls[1] }} times")
+        assertTrue(picks.count { it.baseUrl == urls[0] } > picks.count { it.baseUrl == urls[1] })
+    }
+
+    @Test
+    fun apiFailsOverToAMirror() = runTest {
+        val engine = MockEngine.config {
+            addHandler { request ->
+                when (request.url.host) {
+                    "eu.local" -> respondError(HttpStatusCode.ServiceUnavailable)
+                    else -> if (request.url.parameters["category"] == "unknown") {
+                        respondError(HttpStatusCode.NotFound)
+                    } else {
+                        respond("""["dev"]""", headers = headersOf(HttpHeaders.ContentType, ContentType.Application.Json.toString()))
+                    }
+                }
+            }
+        }
+        val api = ChuckNorrisApiImpl(
+            ChuckNorrisApiConfig(baseUrl = urls[0], engineFactory = engine, routing = EndpointRouting(mirrors = urls.drop(1)))
+        )
+
+        assertEquals(listOf("dev"), api.getCategories())
+        assertFailsWith<Exception> { api.getRandomJokeByCategory("unknown") }
+
+        val status = api.endpointStatus().associateBy { it.baseUrl }
+        assertTrue(status.getValue(urls[0]).errorRate > 0.0)
+        // A client error is not the mirror's fault
+        urls.drop(1).forEach { assertEquals(0.0, status.getValue(it).errorRate) }
+    }
+
+    @Test
+    fun apiFailsOverWhenAnEndpointQueueIsFull() = runTest {
+        val gate = CompletableDeferred<Unit>()
+        val sent = MutableStateFlow(0)
+        val engine = MockEngine.config {
+            addHandler {
+                sent.update { it + 1 }
+                gate.await()
+                respond("""["dev"]""", headers = headersOf(HttpHeaders.ContentType, ContentType.Application.Json.toString()))
+            }
+        }
+        val api = ChuckNorrisApiImpl(
+            ChuckNorrisApiConfig(
+                baseUrl = urls[0],
+                engineFactory = engine,
+                routing = EndpointRouting(mirrors = urls.slice(1..1)),
+                admission = AdmissionControl(maxInFlight = 1, maxQueued = 0)
+            )
+        )
+        val calls = List(2) { async { api.getCategories() } }
+        // Each endpoint runs one call, whichever endpoint the second call picked first
+        sent.first { it == 2 }
+
+        val error = assertFailsWith<Exception> { api.getCategories() }
+
+        assertIs<RequestRejectedException>(error.cause)
+        // The third call was shed by both endpoints before it gave up, without blaming either
+        api.admissionStats().forEach { assertTrue(it.rejected >= 1, it.baseUrl) }
+        api.endpointStatus().forEach { assertEquals(0.0, it.errorRate) }
+        gate.complete(Unit)
+        calls.awaitAll().forEach { assertEquals(listOf("dev"), it) }
+    }
+}
+
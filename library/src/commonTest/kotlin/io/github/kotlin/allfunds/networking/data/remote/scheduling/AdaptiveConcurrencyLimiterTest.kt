@@ -0,0 +1,103 @@
+package io.github.kotlin.allfunds.networking.data.remote.scheduling
+
+import io.github.kotlin.allfunds.networking.data.remote.RequestRejectedException
+import io.github.kotlin.allfunds.networking.data.remote.UnexpectedStatusException
+import io.ktor.http.HttpStatusCode
+import kotlinx.coroutines.CompletableDeferred
+import kotlinx.coroutines.async
+import kotlinx.coroutines.awaitAll
+import kotlinx.coroutines.delay
+import kotlinx.coroutines.launch
+import kotlinx.coroutines.test.TestScope
+import kotlinx.coroutines.test.advanceTimeBy
+import kotlinx.coroutines.test.runCurrent
+import kotlinx.coroutines.test.runTest
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertFailsWith
+import kotlin.test.assertTrue
+import kotlin.time.Duration
+import kotlin.time.Duration.Companion.milliseconds
+import kotlin.time.Duration.Companion.minutes
+
+class AdaptiveConcurrencyLimiterTest {
+
+    private fun TestScope.limiter(initialLimit: Int, maxQueued: Int = 1_000, maxWait: Duration = 1.minutes) =
+        AdaptiveConcurrencyLimiter(
+            initialLimit = initialLimit,
+            maxQueued = maxQueued,
+            maxWait = maxWait,
+            timeSource = testScheduler.timeSource
+        )
+
+    private suspend fun TestScope.load(limiter: AdaptiveConcurrencyLimiter, calls: Int, rtt: Duration) {
+        List(calls) { async { limiter.run { delay(rtt) } } }.awaitAll()
+    }
+
+    @Test
+    fun limitGrowsWhileLatencyStaysFlat() = runTest {
+        val limiter = limiter(initialLimit = 4)
+
+        load(limiter, calls = 200, rtt = 10.milliseconds)
+
+        assertTrue(limiter.limit() > 4, "limit is ${limiter.limit()}")
+    }
+
+    @Test
+    fun limitShrinksWhenLatencyRises() = runTest {
+        val limiter = limiter(initialLimit = 40)
+        load(limiter, calls = 40, rtt = 10.milliseconds)
+        val healthy = limiter.limit()
+
+        load(limiter, calls = 400, rtt = 100.milliseconds)
+
+        assertTrue(limiter.limit() < healthy, "limit went from $healthy to ${limiter.limit()}")
+    }
+
+    @Test
+    fun failuresCutTheLimit() = runTest {
+        val limiter = limiter(initialLimit = 10)
+
+        repeat(5) {
+            assertFailsWith<IllegalStateException> { limiter.run { error("server overloaded") } }
+        }
+
+        assertEquals(5, limiter.limit())
+        assertEquals(0, limiter.inFlight())
+    }
+
+    @Test
+    fun clientErrorsLeaveTheLimitUnchanged() = runTest {
+        val limiter = limiter(initialLimit = 10)
+
+        repeat(20) {
+            assertFailsWith<UnexpectedStatusException> {
+                limiter.run { throw UnexpectedStatusException(HttpStatusCode.NotFound) }
+            }
+        }
+
+        assertEquals(10, limiter.limit())
+        assertEquals(0, limiter.inFlight())
+    }
+
+    @Test
+    fun excessCallsAreQueuedThenRejected() = runTest {
+        val limiter = limiter(initialLimit = 1, maxQueued = 1, maxWait = 100.milliseconds)
+        val gate = CompletableDeferred<Unit>()
+        launch { limiter.run { gate.await() } }
+        val queued = async { runCatching { limiter.run { } } }
+        runCurrent()
+        assertEquals(1, limiter.queued())
+
+        assertFailsWith<RequestRejectedException> { limiter.run { } }
+
+        advanceTimeBy(101.milliseconds)
+        assertTrue(queued.await().exceptionOrNull() is RequestRejectedException)
+        assertEquals(2, limiter.rejections())
+        assertEquals(0, limiter.queued())
+
+        gate.complete(Unit)
+        runCurrent()
+        assertEquals(0, limiter.inFlight())
+    }
+}
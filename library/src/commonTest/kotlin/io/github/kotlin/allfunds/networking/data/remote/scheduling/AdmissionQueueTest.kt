@@ -0,0 +1,104 @@
+package io.github.kotlin.allfunds.networking.data.remote.scheduling
+
+import io.github.kotlin.allfunds.networking.data.remote.RequestRejectedException
+import kotlinx.coroutines.CompletableDeferred
+import kotlinx.coroutines.async
+import kotlinx.coroutines.awaitAll
+import kotlinx.coroutines.delay
+import kotlinx.coroutines.launch
+import kotlinx.coroutines.test.TestScope
+import kotlinx.coroutines.test.advanceTimeBy
+import kotlinx.coroutines.test.runCurrent
+import kotlinx.coroutines.test.runTest
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertFailsWith
+import kotlin.time.Duration.Companion.milliseconds
+import kotlin.time.Duration.Companion.seconds
+
+class AdmissionQueueTest {
+
+    private fun TestScope.queue(control: AdmissionControl) =
+        AdmissionQueue("https://api.local/jokes", control, testScheduler.timeSource)
+
+    /**
+     * Run [calls] calls of [work] milliseconds at once
+     * @return The reason each call was rejected, or null when it ran
+     */
+    private suspend fun TestScope.burst(queue: AdmissionQueue, calls: Int, work: Int) =
+        List(calls) {
+            async {
+                try {
+                    queue.run { delay(work.milliseconds) }
+                    null
+                } catch (e: RequestRejectedException) {
+                    e.reason
+                }
+            }
+        }.awaitAll()
+
+    @Test
+    fun overflowIsRejectedAtOnce() = runTest {
+        val queue = queue(AdmissionControl(maxInFlight = 1, maxQueued = 1))
+        val gate = CompletableDeferred<Unit>()
+        launch { queue.run { gate.await() } }
+        launch { queue.run { } }
+        runCurrent()
+
+        val error = assertFailsWith<RequestRejectedException> { queue.run { } }
+
+        assertEquals(RequestRejectedException.Reason.QUEUE_FULL, error.reason)
+        assertEquals(AdmissionStats("https://api.local/jokes", 1, 1, 1, 0, 0), queue.stats())
+        gate.complete(Unit)
+    }
+
+    @Test
+    fun callsGiveUpAfterTheLongestQueueTime() = runTest {
+        val queue = queue(AdmissionControl(maxInFlight = 1, maxQueueTime = 1.seconds, codel = false))
+        val gate = CompletableDeferred<Unit>()
+        launch { queue.run { gate.await() } }
+        val waiting = async { runCatching { queue.run { } } }
+        advanceTimeBy(1.seconds + 1.milliseconds)
+
+        val error = waiting.await().exceptionOrNull() as RequestRejectedException
+        assertEquals(RequestRejectedException.Reason.QUEUE_TIMEOUT, error.reason)
+        assertEquals(1L, queue.stats().timedOut)
+        gate.complete(Unit)
+    }
+
+    @Test
+    fun backedUpQueueDropsStaleCalls() = runTest {
+        val control = AdmissionControl(
+            maxInFlight = 1,
+            maxQueueTime = 10.seconds,
+            codelTarget = 100.milliseconds,
+            codelInterval = 500.milliseconds
+        )
+
+        // Two calls run before the queue counts as backed up, the stale rest is dropped
+        val reasons = burst(queue(control), calls = 5, work = 300)
+        assertEquals(listOf(null, null) + List(3) { RequestRejectedException.Reason.DROPPED }, reasons)
+        assertEquals(600L, testScheduler.currentTime)
+
+        // Without CoDel every call runs, each one waiting longer than the last
+        val queued = burst(queue(control.copy(codel = false)), calls = 5, work = 300)
+        assertEquals(List(5) { null }, queued)
+    }
+
+    @Test
+    fun cancelledCallsLeaveTheQueue() = runTest {
+        val queue = queue(AdmissionControl(maxInFlight = 1))
+        val gate = CompletableDeferred<Unit>()
+        launch { queue.run { gate.await() } }
+        val waiting = launch { queue.run { } }
+        runCurrent()
+
+        waiting.cancel()
+        runCurrent()
+
+        assertEquals(0, queue.stats().queued)
+        gate.complete(Unit)
+        runCurrent()
+        assertEquals(0, queue.stats().inFlight)
+    }
+}
@@ -0,0 +1,141 @@
+package io.github.kotlin.allfunds.networking.data.remote.scheduling
+
+import io.github.kotlin.allfunds.networking.data.remote.ChuckNorrisApiConfig
+import io.github.kotlin.allfunds.networking.data.remote.ChuckNorrisApiImpl
+import io.github.kotlin.allfunds.networking.loadtest.ChuckNorrisStubServer
+import kotlinx.coroutines.CompletableDeferred
+import kotlinx.coroutines.CoroutineScope
+import kotlinx.coroutines.Job
+import kotlinx.coroutines.launch
+import kotlinx.coroutines.test.runCurrent
+import kotlinx.coroutines.test.runTest
+import kotlinx.coroutines.withContext
+import kotlin.test.Test
+import kotlin.test.assertEquals
+
+class RequestSchedulerTest {
+
+    private val interactive = RequestScheduling(RequestPriority.INTERACTIVE)
+    private val background = RequestScheduling(RequestPriority.BACKGROUND)
+
+    /**
+     * Launch a request that records its start in [started] and holds its slot until [gate] completes
+     */
+    private fun CoroutineScope.request(
+        scheduler: RequestScheduler,
+        scheduling: RequestScheduling,
+        name: String,
+        started: MutableList<String>,
+        gate: CompletableDeferred<Unit>,
+        host: String = HOST
+    ): Job = launch {
+        scheduler.run(host, scheduling) {
+            started += name
+            gate.await()
+        }
+    }
+
+    @Test
+    fun interactiveRequestsOvertakeQueuedBackgroundWork() = runTest {
+        val scheduler = RequestScheduler(maxInFlightPerHost = 1, reservedSlots = 0)
+        val started = mutableListOf<String>()
+        val gates = List(5) { CompletableDeferred<Unit>() }
+
+        request(scheduler, background, "running", started, gates[0])
+        runCurrent()
+        for (i in 1..3) request(scheduler, background, "background-$i", started, gates[i])
+        request(scheduler, interactive, "interactive", started, gates[4])
+        runCurrent()
+
+        gates.forEach { it.complete(Unit) }
+        runCurrent()
+
+        assertEquals(listOf("running", "interactive", "background-1", "background-2", "background-3"), started)
+    }
+
+    @Test
+    fun backgroundWorkLeavesReservedSlotsFree() = runTest {
+        val scheduler = RequestScheduler(maxInFlightPerHost = 3, reservedSlots = 1)
+        val started = mutableListOf<String>()
+        val gate = CompletableDeferred<Unit>()
+
+        repeat(4) { request(scheduler, background, "background-$it", started, gate) }
+        runCurrent()
+        assertEquals(2, scheduler.inFlight())
+
+        request(scheduler, interactive, "interactive", started, gate)
+        runCurrent()
+        assertEquals(3, scheduler.inFlight())
+        assertEquals("interactive", started.last())
+
+        // Other hosts have their own slots
+        request(scheduler, background, "other-host", started, gate, host = "other.local")
+        runCurrent()
+        assertEquals(4, scheduler.inFlight())
+
+        gate.complete(Unit)
+        runCurrent()
+        assertEquals(0, scheduler.queued())
+    }
+
+    @Test
+    fun tagsShareSlotsByWeight() = runTest {
+        val scheduler = RequestScheduler(maxInFlightPerHost = 1, reservedSlots = 0, tagWeights = mapOf("search" to 2))
+        val started = mutableListOf<String>()
+        val gates = List(13) { CompletableDeferred<Unit>() }
+
+        request(scheduler, RequestScheduling.DEFAULT, "running", started, gates[0])
+        runCurrent()
+        for (i in 1..6) {
+            request(scheduler, RequestScheduling(RequestPriority.NORMAL, "search"), "search", started, gates[i])
+            request(scheduler, RequestScheduling(RequestPriority.NORMAL, "categories"), "categories", started, gates[6 + i])
+        }
+        runCurrent()
+
+        for (gate in gates) {
+            gate.complete(Unit)
+            runCurrent()
+        }
+
+        val firstSix = started.drop(1).take(6)
+        assertEquals(4, firstSix.count { it == "search" })
+        assertEquals(2, firstSix.count { it == "categories" })
+    }
+
+    @Test
+    fun cancelledWaitersGiveUpTheirPlace() = runTest {
+        val scheduler = RequestScheduler(maxInFlightPerHost = 1, reservedSlots = 0)
+        val started = mutableListOf<String>()
+        val gate = CompletableDeferred<Unit>()
+
+        request(scheduler, RequestScheduling.DEFAULT, "running", started, gate)
+        val cancelled = request(scheduler, interactive, "cancelled", started, gate)
+        request(scheduler, RequestScheduling.DEFAULT, "waiting", started, gate)
+        runCurrent()
+        cancelled.cancel()
+        gate.complete(Unit)
+        runCurrent()
+
+        assertEquals(listOf("running", "waiting"), started)
+        assertEquals(0, scheduler.inFlight())
+    }
+
+    @Test
+    fun apiCallsRunThroughTheScheduler() = runTest {
+        val server = ChuckNorrisStubServer()
+        val scheduler = RequestScheduler()
+        val api = ChuckNorrisApiImpl(
+            ChuckNorrisApiConfig(baseUrl = server.baseUrl, engineFactory = server.engineFactory(), scheduler = scheduler)
+        )
+
+        withContext(background) { api.getCategories() }
+        api.getRandomJoke()
+
+        assertEquals(2, server.totalRequests)
+        assertEquals(0, scheduler.inFlight())
+    }
+
+    private companion object {
+        const val HOST = "stub.local"
+    }
+}
@@ -0,0 +1,143 @@
+package io.github.kotlin.allfunds.networking.data.remote.slo
+
+import io.github.kotlin.allfunds.networking.data.remote.ChuckNorrisApiConfig
+import io.github.kotlin.allfunds.networking.data.remote.ChuckNorrisApiImpl
+import io.github.kotlin.allfunds.networking.domain.model.SearchProjection
+import io.ktor.client.engine.mock.MockEngine
+import io.ktor.client.engine.mock.respond
+import io.ktor.client.engine.mock.respondError
+import io.ktor.http.ContentType
+import io.ktor.http.HttpHeaders
+import io.ktor.http.HttpStatusCode
+import io.ktor.http.headersOf
+import kotlinx.coroutines.test.runTest
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertFailsWith
+import kotlin.time.Duration
+import kotlin.time.Duration.Companion.milliseconds
+import kotlin.time.Duration.Companion.seconds
+import kotlin.time.TestTimeSource
+
+class SloControllerTest {
+
+    private val time = TestTimeSource()
+    private var latency = Duration.ZERO
+    private var failing = false
+    private var notFound = false
+    private var calls = 0
+
+    private val slo = SloController(
+        latencyBudget = 100.milliseconds,
+        minSamples = 3,
+        probeInterval = 5.seconds,
+        recoveryProbes = 2,
+        timeSource = time
+    )
+
+    // Each response takes [latency] on the controller's clock
+    private val engine = MockEngine.config {
+        addHandler { request ->
+            calls++
+            time += latency
+            val body = when (request.url.encodedPath.substringAfterLast('/')) {
+                "categories" -> """["dev"]"""
+                "search" -> """{"total":1,"result":[{"id":"a1","url":"","value":"Found","categories":[]}]}"""
+                else -> """{"id":"r1","url":"","value":"Random","categories":["dev"]}"""
+            }
+            if (failing) {
+                respondError(HttpStatusCode.ServiceUnavailable)
+            } else if (notFound) {
+                respondError(HttpStatusCode.NotFound)
+            } else {
+                respond(body, headers = headersOf(HttpHeaders.ContentType, ContentType.Application.Json.toString()))
+            }
+        }
+    }
+
+    private val api = ChuckNorrisApiImpl(ChuckNorrisApiConfig(baseUrl = "https://api.local/jokes", engineFactory = engine, slo = slo))
+
+    private suspend fun breachCategories() {
+        latency = 500.milliseconds
+        repeat(3) { api.getCategories() }
+    }
+
+    @Test
+    fun slowOperationIsAnsweredFromKeptData() = runTest {
+        breachCategories()
+        assertEquals(SloMode.DEGRADED, slo.mode("/categories"))
+
+        assertEquals(listOf("dev"), api.getCategories())
+        assertEquals(3, calls)
+        // Other operations keep their own budget
+        assertEquals("r1", api.getRandomJoke().id)
+        assertEquals(SloMode.HEALTHY, slo.mode("/random"))
+
+        val status = slo.status().single { it.operation == "/categories" }
+        assertEquals(1, status.transitions)
+        assertEquals(1L, status.localAnswers)
+        assertEquals(500.milliseconds, status.latency)
+    }
+
+    @Test
+    fun probesWithinBudgetEndTheDegradedPeriod() = runTest {
+        breachCategories()
+        latency = 10.milliseconds
+
+        time += 5.seconds
+        api.getCategories()
+        api.getCategories()
+        assertEquals(4, calls, "only one probe per interval goes upstream")
+
+        time += 5.seconds
+        api.getCategories()
+        assertEquals(SloMode.HEALTHY, slo.mode("/categories"))
+
+        val status = slo.status().single()
+        assertEquals(2, status.transitions)
+        assertEquals(10.seconds + 20.milliseconds, status.timeDegraded)
+        assertEquals(0, status.samples)
+    }
+
+    @Test
+    fun failedProbeFallsBackAndMissingDataGoesUpstream() = runTest {
+        api.searchJokes("found", SearchProjection.FULL)
+        latency = 500.milliseconds
+        repeat(2) { api.searchJokes("found", SearchProjection.IDS) }
+        assertEquals(SloMode.DEGRADED, slo.mode("/search"))
+
+        failing = true
+        time += 5.seconds
+        val result = api.searchJokes("found", SearchProjection.IDS_AND_TEXT)
+        assertEquals("Found", result.jokes.single().value)
+        assertEquals(4, calls)
+
+        // Nothing kept for this query, so it still goes to the API and fails
+        assertFailsWith<Exception> { api.searchJokeList("missing") }
+        assertEquals(5, calls)
+    }
+
+    @Test
+    fun clientErrorsAreNeitherSampledNorCountedAsProbes() = runTest {
+        notFound = true
+        repeat(3) { assertFailsWith<Exception> { api.getCategories() } }
+        notFound = false
+        assertEquals(0, slo.status().single().samples)
+
+        breachCategories()
+        latency = 10.milliseconds
+        notFound = true
+        repeat(2) {
+            time += 5.seconds
+            assertFailsWith<Exception> { api.getCategories() }
+        }
+        assertEquals(SloMode.DEGRADED, slo.mode("/categories"))
+
+        notFound = false
+        repeat(2) {
+            time += 5.seconds
+            api.getCategories()
+        }
+        assertEquals(SloMode.HEALTHY, slo.mode("/categories"))
+    }
+}
@@ -0,0 +1,46 @@
+package io.github.kotlin.allfunds.networking.di
+
+import io.github.kotlin.allfunds.networking.ChuckNorrisClient
+import io.github.kotlin.allfunds.networking.domain.usecase.SearchJokesUseCase
+import io.github.kotlin.allfunds.networking.loadtest.ChuckNorrisStubServer
+import io.github.kotlin.allfunds.networking.loadtest.stubClient
+import kotlinx.coroutines.Dispatchers
+import kotlinx.coroutines.async
+import kotlinx.coroutines.awaitAll
+import kotlinx.coroutines.test.runTest
+import kotlinx.coroutines.withContext
+import org.koin.core.context.stopKoin
+import org.koin.mp.KoinPlatformTools
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertNotSame
+import kotlin.test.assertNull
+import kotlin.test.assertSame
+
+class KoinInitializerTest {
+
+    @Test
+    fun concurrentInitReturnsOneContainer() = runTest {
+        val applications = withContext(Dispatchers.Default) {
+            List(32) { async { KoinInitializer.init() } }.awaitAll()
+        }
+
+        assertEquals(1, applications.distinctBy { it.koin }.size)
+        assertSame(applications.first(), KoinInitializer.init())
+        // The library container is private to the library
+        assertNull(KoinPlatformTools.defaultContext().getOrNull())
+    }
+
+    @Test
+    fun runningGlobalKoinTakesPrecedence() {
+        val client = stubClient(ChuckNorrisStubServer())
+        try {
+            assertSame(KoinPlatformTools.defaultContext().get(), client.getKoin())
+            assertNotSame(KoinInitializer.init().koin, client.getKoin())
+        } finally {
+            stopKoin()
+        }
+        // Stopping the global container leaves the library one usable
+        ChuckNorrisClient().getKoin().get<SearchJokesUseCase>()
+    }
+}
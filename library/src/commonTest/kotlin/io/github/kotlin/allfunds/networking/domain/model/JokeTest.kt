@@ -0,0 +1,76 @@
+package io.github.kotlin.allfunds.networking.domain.model
+
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertFalse
+import kotlin.test.assertNotEquals
+import kotlin.test.assertSame
+
+class JokeTest {
+
+    private val apiJoke = Joke(
+        id = "ad7wv_-nT3akj0w0Y6XmJQ",
+        value = "Chuck Norris can divide by zero.",
+        url = "https://api.chucknorris.io/jokes/ad7wv_-nT3akj0w0Y6XmJQ",
+        categories = listOf("dev", "science")
+    )
+
+    @Test
+    fun compactJokeReturnsConstructorValues() {
+        assertEquals("ad7wv_-nT3akj0w0Y6XmJQ", apiJoke.id)
+        assertEquals("Chuck Norris can divide by zero.", apiJoke.value)
+        assertEquals("https://api.chucknorris.io/jokes/ad7wv_-nT3akj0w0Y6XmJQ", apiJoke.url)
+        assertEquals(listOf("dev", "science"), apiJoke.categories)
+    }
+
+    @Test
+    fun irregularFieldsArePreservedExactly() {
+        val joke = Joke(
+            id = "test-id",
+            value = "Test joke",
+            url = "https://example.com/custom",
+            categories = listOf("test", "dev", "dev")
+        )
+
+        assertEquals("test-id", joke.id)
+        assertEquals("https://example.com/custom", joke.url)
+        assertEquals(listOf("test", "dev", "dev"), joke.categories)
+    }
+
+    @Test
+    fun knownCategoriesAreInterned() {
+        val joke = Joke("test-id", "Test joke", "https://api.chucknorris.io/jokes/test-id", listOf(buildString { append("dev") }))
+
+        assertSame(CategoryRegistry.intern("dev"), joke.categories.single())
+    }
+
+    @Test
+    fun behavesLikeTheFormerDataClass() {
+        val (id, value, url, categories) = apiJoke
+        val same = Joke(id, value, url, categories)
+        val other = apiJoke.copy(value = "Chuck Norris counted to infinity. Twice.")
+
+        assertEquals(apiJoke, same)
+        assertEquals(apiJoke.hashCode(), same.hashCode())
+        assertNotEquals(apiJoke, other)
+        assertEquals(apiJoke.id, other.id)
+        assertEquals(
+            "Joke(id=ad7wv_-nT3akj0w0Y6XmJQ, value=Chuck Norris can divide by zero., " +
+                "url=https://api.chucknorris.io/jokes/ad7wv_-nT3akj0w0Y6XmJQ, categories=[dev, science])",
+            apiJoke.toString()
+        )
+    }
+
+    @Test
+    fun hashingLazyJokesDoesNotDecodeTheirText() {
+        val utf8 = "Chuck Norris can divide by zero.".encodeToByteArray()
+        val lazy = { id: String -> Joke(id, utf8.copyOf(), 0, utf8.size, Joke.URL_PREFIX + id, listOf("dev")) }
+        val jokes = HashSet<Joke>()
+
+        listOf("ad7wv_-nT3akj0w0Y6XmJQ", "test-id", "ad7wv_-nT3akj0w0Y6XmJQ", "test-id").forEach { jokes += lazy(it) }
+
+        assertEquals(2, jokes.size)
+        assertEquals(apiJoke.hashCode(), lazy(apiJoke.id).hashCode())
+        jokes.forEach { assertFalse(it.isValueDecoded) }
+    }
+}
@@ -0,0 +1,117 @@
+package io.github.kotlin.allfunds.networking.domain.paging
+
+import io.github.kotlin.allfunds.networking.domain.model.Joke
+import kotlinx.coroutines.test.TestScope
+import kotlinx.coroutines.test.runCurrent
+import kotlinx.coroutines.test.runTest
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertNull
+import kotlin.test.assertSame
+
+class JokePagerTest {
+
+    private val config = PagingConfig(pageSize = 10, prefetchDistance = 10, maxPages = 3)
+
+    private fun joke(index: Int) = Joke(id = "joke-$index", value = "Joke $index", url = "", categories = emptyList())
+
+    private var searches = 0
+    private var failSearch = false
+
+    private val searchSource = SearchJokePageSource {
+        searches++
+        if (failSearch) Result.failure(IllegalStateException("offline")) else Result.success(List(25) { joke(it) })
+    }
+
+    /**
+     * Endless source recording the pages it is asked for
+     */
+    private class EndlessSource : JokePageSource {
+        val loaded = ArrayList<Int>()
+
+        override suspend fun load(page: Int, pageSize: Int): Result<JokePage> {
+            loaded += page
+            return Result.success(JokePage(List(pageSize) { Joke("joke-${page * pageSize + it}", "", "", emptyList()) }, last = false))
+        }
+    }
+
+    private fun TestScope.pager(source: JokePageSource) = JokePager(source, backgroundScope, config)
+
+    @Test
+    fun pagesWithinThePrefetchDistanceAreLoadedAhead() = runTest {
+        val source = EndlessSource()
+        val pager = pager(source)
+
+        pager.onVisible(0)
+        runCurrent()
+        assertEquals(setOf(0, 1), pager.state.value.pages.keys)
+
+        pager.onVisible(15)
+        runCurrent()
+        assertEquals(listOf(0, 1, 2), source.loaded)
+        assertEquals("joke-25", pager.state.value[25]?.id)
+    }
+
+    @Test
+    fun pagesFarFromTheVisibleJokeAreDropped() = runTest {
+        val pager = pager(EndlessSource())
+        pager.onVisible(0)
+        runCurrent()
+
+        pager.onVisible(105)
+        runCurrent()
+
+        assertEquals(setOf(9, 10, 11), pager.state.value.pages.keys)
+        assertNull(pager.state.value[0])
+    }
+
+    @Test
+    fun searchIsDecodedOnceAndEndsAtItsLastPage() = runTest {
+        val pager = pager(searchSource)
+
+        pager.onVisible(0)
+        runCurrent()
+        pager.onVisible(24)
+        runCurrent()
+
+        val state = pager.state.value
+        assertEquals(1, searches)
+        assertEquals(25, state.itemCount)
+        assertEquals(setOf(0, 1, 2), state.pages.keys)
+        assertEquals("joke-24", state[24]?.id)
+        assertEquals(emptySet(), state.loading)
+    }
+
+    @Test
+    fun invalidateReloadsFromFreshData() = runTest {
+        val pager = pager(searchSource)
+        pager.onVisible(0)
+        runCurrent()
+
+        pager.invalidate()
+        runCurrent()
+
+        assertEquals(2, searches)
+        assertEquals(setOf(0, 1), pager.state.value.pages.keys)
+    }
+
+    @Test
+    fun failedLoadsWaitForRetry() = runTest {
+        failSearch = true
+        val pager = pager(searchSource)
+        pager.onVisible(0)
+        runCurrent()
+        val error = pager.state.value.error
+        assertEquals("offline", error?.message)
+
+        pager.onVisible(5)
+        runCurrent()
+        assertSame(error, pager.state.value.error)
+
+        failSearch = false
+        pager.retry()
+        runCurrent()
+        assertNull(pager.state.value.error)
+        assertEquals(setOf(0, 1), pager.state.value.pages.keys)
+    }
+}
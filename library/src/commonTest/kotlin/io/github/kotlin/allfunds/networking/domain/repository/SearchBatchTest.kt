@@ -0,0 +1,100 @@
+package io.github.kotlin.allfunds.networking.domain.repository
+
+import io.github.kotlin.allfunds.networking.domain.model.Joke
+import kotlinx.coroutines.delay
+import kotlinx.coroutines.test.runTest
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertSame
+import kotlin.test.assertTrue
+
+class SearchBatchTest {
+
+    /**
+     * Answers searches by substring match over [jokes], like the API, recording the queries sent
+     */
+    private class CorpusRepository(private val jokes: List<Pair<String, String>>) : JokeRepository {
+        val sent = ArrayList<String>()
+        var running = 0
+        var maxRunning = 0
+
+        override suspend fun searchJokes(query: String): Result<List<Joke>> {
+            sent += query
+            running++
+            maxRunning = maxOf(maxRunning, running)
+            delay(10)
+            running--
+            if (query == "fail") return Result.failure(IllegalStateException("search failed"))
+            // A fresh instance per response, as decoding produces
+            return Result.success(
+                jokes.filter { (_, text) -> text.contains(query, ignoreCase = true) }
+                    .map { (id, text) -> Joke(id, text, "https://api.chucknorris.io/jokes/$id", emptyList()) }
+            )
+        }
+
+        override suspend fun getRandomJoke(): Result<Joke> = error("not used")
+
+        override suspend fun getRandomJokeByCategory(category: String): Result<Joke> = error("not used")
+
+        override suspend fun getCategories(): Result<List<String>> = error("not used")
+    }
+
+    private val repository = CorpusRepository(
+        listOf(
+            "a1" to "Chuck Norris can divide by zero",
+            "a2" to "Chuck Norris counted to infinity, twice",
+            "a3" to "Time waits for Chuck Norris",
+            "a4" to "Infinity waits for nobody"
+        )
+    )
+
+    @Test
+    fun onlyIdenticalQueriesAreCollapsed() = runTest {
+        val queries = listOf("chuck", "infinity", "chuck", "Chuck", "chuck norris can")
+
+        val hits = repository.searchJokesBatch(queries, maxConcurrency = 1).getOrThrow()
+
+        assertEquals(listOf("chuck", "infinity", "Chuck", "chuck norris can"), repository.sent)
+        for (query in queries) {
+            assertEquals(repository.searchJokes(query).getOrThrow(), hits.getValue(query))
+        }
+    }
+
+    @Test
+    fun jokesFoundBySeveralQueriesAreShared() = runTest {
+        val hits = repository.searchJokesBatch(listOf("chuck", "infinity", "waits")).getOrThrow()
+
+        val a2 = hits.getValue("chuck").single { it.id == "a2" }
+        assertSame(a2, hits.getValue("infinity").single { it.id == "a2" })
+        val a3 = hits.getValue("chuck").single { it.id == "a3" }
+        assertSame(a3, hits.getValue("waits").single { it.id == "a3" })
+    }
+
+    @Test
+    fun laterSearchesSeeTheJokesFoundEarlier() = runTest {
+        val reused = ArrayList<String>()
+
+        val hits = searchBatch(listOf("chuck", "infinity"), maxConcurrency = 1) { query, known ->
+            repository.searchJokes(query).map { jokes -> jokes.map { joke -> known(joke.id)?.also { reused += it.id } ?: joke } }
+        }.getOrThrow()
+
+        assertEquals(listOf("a2"), reused)
+        assertSame(hits.getValue("chuck")[1], hits.getValue("infinity")[0])
+    }
+
+    @Test
+    fun searchesRunConcurrentlyUpToTheLimit() = runTest {
+        repository.searchJokesBatch(listOf("zero", "twice", "time", "nobody", "divide"), maxConcurrency = 2).getOrThrow()
+
+        assertEquals(5, repository.sent.size)
+        assertEquals(2, repository.maxRunning)
+    }
+
+    @Test
+    fun aFailedSearchFailsTheBatch() = runTest {
+        val result = repository.searchJokesBatch(listOf("chuck", "fail"))
+
+        assertTrue(result.isFailure)
+        assertEquals("search failed", result.exceptionOrNull()?.message)
+    }
+}
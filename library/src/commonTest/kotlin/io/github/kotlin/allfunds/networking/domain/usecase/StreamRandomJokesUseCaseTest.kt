@@ -0,0 +1,108 @@
+package io.github.kotlin.allfunds.networking.domain.usecase
+
+import io.github.kotlin.allfunds.networking.domain.model.Joke
+import io.github.kotlin.allfunds.networking.domain.repository.JokeRepository
+import kotlinx.coroutines.CancellationException
+import kotlinx.coroutines.delay
+import kotlinx.coroutines.flow.first
+import kotlinx.coroutines.flow.map
+import kotlinx.coroutines.flow.take
+import kotlinx.coroutines.flow.toList
+import kotlinx.coroutines.launch
+import kotlinx.coroutines.test.TestScope
+import kotlinx.coroutines.test.advanceTimeBy
+import kotlinx.coroutines.test.advanceUntilIdle
+import kotlinx.coroutines.test.runTest
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertTrue
+import kotlin.time.Duration
+import kotlin.time.Duration.Companion.milliseconds
+import kotlin.time.Duration.Companion.seconds
+
+class StreamRandomJokesUseCaseTest {
+
+    private fun TestScope.useCase(repository: JokeRepository) =
+        StreamRandomJokesUseCase(repository, testScheduler.timeSource)
+
+    @Test
+    fun nextJokesAreFetchedWhileTheCollectorIsBusyUpToThePrefetch() = runTest {
+        val repository = SequenceJokeRepository(latency = 100.milliseconds)
+        val collector = launch {
+            useCase(repository)(prefetch = 1).collect { delay(10.seconds) }
+        }
+
+        advanceTimeBy(5.seconds)
+        // One joke being handled, one buffered, one waiting for buffer space
+        assertEquals(3, repository.calls)
+
+        collector.cancel()
+    }
+
+    @Test
+    fun requestsArePacedToTheTargetRate() = runTest {
+        val jokes = useCase(SequenceJokeRepository())(targetRate = 2.0).take(5).toList()
+
+        assertEquals(5, jokes.size)
+        assertEquals(2_000L, testScheduler.currentTime)
+    }
+
+    @Test
+    fun repeatsWithinTheWindowAreSkipped() = runTest {
+        val repository = SequenceJokeRepository(ids = listOf("a", "a", "b", "a", "c"))
+
+        val ids = useCase(repository)(dedupWindow = 2).take(3).map { it.id }.toList()
+
+        assertEquals(listOf("a", "b", "c"), ids)
+    }
+
+    @Test
+    fun aPoolSmallerThanTheWindowStillStreams() = runTest {
+        val repository = SequenceJokeRepository(ids = listOf("a"))
+
+        val ids = useCase(repository)(prefetch = 0).take(2).map { it.id }.toList()
+
+        assertEquals(listOf("a", "a"), ids)
+        assertTrue(repository.calls >= 2 + StreamRandomJokesUseCase.MAX_REPEATS)
+    }
+
+    @Test
+    fun cancellingTheCollectionCancelsTheRequestInFlight() = runTest {
+        val repository = SequenceJokeRepository(latency = 1.seconds)
+
+        useCase(repository)().first()
+        advanceUntilIdle()
+
+        assertEquals(2, repository.calls)
+        assertEquals(1, repository.cancelled)
+    }
+
+    /**
+     * Returns jokes with the given [ids] in a loop, or new ids when none are given, after [latency]
+     */
+    private class SequenceJokeRepository(
+        private val ids: List<String>? = null,
+        private val latency: Duration = Duration.ZERO
+    ) : JokeRepository {
+        var calls = 0
+        var cancelled = 0
+
+        override suspend fun getRandomJoke(): Result<Joke> {
+            val id = ids?.let { it[calls % it.size] } ?: "joke-$calls"
+            calls++
+            try {
+                delay(latency)
+            } catch (e: CancellationException) {
+                cancelled++
+                throw e
+            }
+            return Result.success(Joke(id = id, value = "Joke $id", url = "https://api.chucknorris.io/jokes/$id", categories = emptyList()))
+        }
+
+        override suspend fun getRandomJokeByCategory(category: String): Result<Joke> = getRandomJoke()
+
+        override suspend fun getCategories(): Result<List<String>> = Result.success(emptyList())
+
+        override suspend fun searchJokes(query: String): Result<List<Joke>> = Result.success(emptyList())
+    }
+}
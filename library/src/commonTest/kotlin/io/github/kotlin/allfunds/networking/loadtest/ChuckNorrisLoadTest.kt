@@ -0,0 +1,69 @@
+package io.github.kotlin.allfunds.networking.loadtest
+
+import io.github.kotlin.allfunds.networking.benchmark.BenchmarkLog
+import kotlinx.coroutines.Dispatchers
+import kotlinx.coroutines.test.runTest
+import kotlinx.coroutines.withContext
+import org.koin.core.context.stopKoin
+import kotlin.test.AfterTest
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertTrue
+import kotlin.time.Duration.Companion.milliseconds
+import kotlin.time.Duration.Companion.seconds
+
+/**
+ * Load tests of the full client stack against the in-process stub server
+ */
+class ChuckNorrisLoadTest {
+
+    @AfterTest
+    fun tearDown() {
+        stopKoin()
+    }
+
+    @Test
+    fun closedLoopSweepCompletesEveryCall() = runTest(timeout = 60.seconds) {
+        val server = ChuckNorrisStubServer(
+            StubServerConfig(randomLatency = LatencyDistribution.Uniform(1.milliseconds, 3.milliseconds))
+        )
+        val generator = LoadGenerator(stubClient(server))
+
+        val concurrencies = listOf(1, 4, 16)
+        val reports = withContext(Dispatchers.Default) {
+            concurrencies.map { concurrency ->
+                generator.run(Workload.ClosedLoop(concurrency, totalCalls = 200), "closed-loop c=$concurrency")
+            }
+        }
+
+        concurrencies.zip(reports).forEach { (concurrency, report) ->
+            BenchmarkLog.append("load-closed-loop", report.metrics() + ("concurrency" to concurrency))
+            assertEquals(200, report.completed)
+            assertEquals(0, report.errors)
+            assertTrue(report.p50 <= report.p99)
+            assertTrue(report.p99 <= report.p999)
+            assertTrue(report.p999 <= report.max)
+        }
+        assertEquals(600, server.totalRequests)
+    }
+
+    @Test
+    fun openLoopReportsServerErrors() = runTest(timeout = 60.seconds) {
+        val server = ChuckNorrisStubServer(
+            StubServerConfig(
+                randomLatency = LatencyDistribution.Exponential(1.milliseconds, 2.milliseconds),
+                errorRate = 0.2
+            )
+        )
+        val generator = LoadGenerator(stubClient(server))
+
+        val report = withContext(Dispatchers.Default) {
+            generator.run(Workload.OpenLoop(ratePerSecond = 200, duration = 1.seconds), "open-loop 200/s")
+        }
+
+        BenchmarkLog.append("load-open-loop", report.metrics())
+        assertEquals(200, report.completed)
+        assertEquals(server.errorCount, report.errors)
+        assertTrue(report.errors > 0)
+    }
+}
@@ -0,0 +1,180 @@
+package io.github.kotlin.allfunds.networking.loadtest
+
+import io.ktor.client.engine.HttpClientEngineConfig
+import io.ktor.client.engine.HttpClientEngineFactory
+import io.ktor.client.engine.config
+import io.ktor.client.engine.mock.MockEngine
+import io.ktor.client.engine.mock.MockRequestHandleScope
+import io.ktor.client.engine.mock.respond
+import io.ktor.client.engine.mock.respondError
+import io.ktor.client.request.HttpRequestData
+import io.ktor.client.request.HttpResponseData
+import io.ktor.http.ContentType
+import io.ktor.http.HttpHeaders
+import io.ktor.http.HttpStatusCode
+import io.ktor.http.headersOf
+import kotlinx.coroutines.delay
+import kotlinx.coroutines.sync.Mutex
+import kotlinx.coroutines.sync.withLock
+import kotlin.concurrent.atomics.AtomicInt
+import kotlin.concurrent.atomics.ExperimentalAtomicApi
+import kotlin.random.Random
+import kotlin.time.Duration
+
+/**
+ * Configuration of the stub server
+ *
+ * @property randomLatency Latency added to `/jokes/random`
+ * @property categoriesLatency Latency added to `/jokes/categories`
+ * @property searchLatency Latency added to `/jokes/search`
+ * @property jokeValueLength Length of every joke text
+ * @property searchResultCount Number of results returned by every search
+ * @property errorRate Fraction of requests answered with a 500
+ * @property seed Seed for latencies, errors and payloads
+ */
+data class StubServerConfig(
+    val randomLatency: LatencyDistribution = LatencyDistribution.None,
+    val categoriesLatency: LatencyDistribution = LatencyDistribution.None,
+    val searchLatency: LatencyDistribution = LatencyDistribution.None,
+    val jokeValueLength: Int = 120,
+    val searchResultCount: Int = 20,
+    val errorRate: Double = 0.0,
+    val seed: Long = 42
+)
+
+/**
+ * Response chosen by the stub server for one request
+ *
+ * @property status HTTP status to answer with
+ * @property body JSON body, empty for errors
+ * @property latency Server-side latency to add before answering
+ */
+data class StubResponse(
+    val status: HttpStatusCode,
+    val body: String,
+    val latency: Duration
+)
+
+/**
+ * In-process stand-in for api.chucknorris.io
+ *
+ * Serves the `/jokes/random`, `/jokes/categories` and `/jokes/search` endpoints through a Ktor
+ * [MockEngine], so [io.github.kotlin.allfunds.networking.data.remote.ChuckNorrisApiImpl] can be
+ * driven end to end without network access.
+ */
+@OptIn(ExperimentalAtomicApi::class)
+class ChuckNorrisStubServer(val config: StubServerConfig = StubServerConfig()) {
+    private val random = Random(config.seed)
+    private val randomLock = Mutex()
+
+    private val randomBodies = List(RANDOM_BODY_POOL_SIZE) {
+        JokeFixtures.encode(JokeFixtures.joke(random, config.jokeValueLength))
+    }
+    private val searchBody = JokeFixtures.encode(
+        JokeFixtures.searchResponse(random, config.searchResultCount, config.jokeValueLength)
+    )
+    private val categoriesBody = JokeFixtures.encodeCategories()
+
+    private val randomRequests = AtomicInt(0)
+    private val categoriesRequests = AtomicInt(0)
+    private val searchRequests = AtomicInt(0)
+    private val errors = AtomicInt(0)
+
+    /**
+     * Number of requests served per endpoint
+     */
+    val requestCounts: Map<String, Int>
+        get() = mapOf(
+            RANDOM_PATH to randomRequests.load(),
+            CATEGORIES_PATH to categoriesRequests.load(),
+            SEARCH_PATH to searchRequests.load()
+        )
+
+    /**
+     * Total number of requests served
+     */
+    val totalRequests: Int
+        get() = requestCounts.values.sum()
+
+    /**
+     * Number of injected 500 responses
+     */
+    val errorCount: Int
+        get() = errors.load()
+
+    /**
+     * Base URL to configure the client with
+     */
+    val baseUrl: String = BASE_URL
+
+    /**
+     * Engine factory serving requests from this stub
+     */
+    fun engineFactory(): HttpClientEngineFactory<HttpClientEngineConfig> = MockEngine.config {
+        addHandler { request -> handle(request) }
+    }
+
+    /**
+     * Decide the response to one request without sending it
+     */
+    suspend fun resolve(request: HttpRequestData): StubResponse {
+        val path = request.url.encodedPath
+        val (latency, fail, index) = randomLock.withLock {
+            val distribution = when (path) {
+                CATEGORIES_PATH -> config.categoriesLatency
+                SEARCH_PATH -> config.searchLatency
+                else -> config.randomLatency
+            }
+            Triple(
+                distribution.sample(random),
+                config.errorRate > 0 && random.nextDouble() < config.errorRate,
+                random.nextInt(randomBodies.size)
+            )
+        }
+        val body = when (path) {
+            RANDOM_PATH -> {
+                randomRequests.incrementAndFetch()
+                randomBodies[index]
+            }
+            CATEGORIES_PATH -> {
+                categoriesRequests.incrementAndFetch()
+                categoriesBody
+            }
+            SEARCH_PATH -> {
+                searchRequests.incrementAndFetch()
+                searchBody
+            }
+            else -> return StubResponse(HttpStatusCode.NotFound, "", Duration.ZERO)
+        }
+        if (fail) {
+            errors.incrementAndFetch()
+            return StubResponse(HttpStatusCode.InternalServerError, "", latency)
+        }
+        return StubResponse(HttpStatusCode.OK, body, latency)
+    }
+
+    /**
+     * Answer one request
+     */
+    suspend fun MockRequestHandleScope.handle(request: HttpRequestData): HttpResponseData {
+        val response = resolve(request)
+        if (response.latency > Duration.ZERO) delay(response.latency)
+        if (response.status != HttpStatusCode.OK) return respondError(response.status)
+        return respond(
+            content = response.body,
+            status = response.status,
+            headers = jsonHeaders
+        )
+    }
+
+    companion object {
+        const val BASE_URL = "http://stub.local/jokes"
+        const val RANDOM_PATH = "/jokes/random"
+        const val CATEGORIES_PATH = "/jokes/categories"
+        const val SEARCH_PATH = "/jokes/search"
+
+        private const val RANDOM_BODY_POOL_SIZE = 64
+
+        val jsonHeaders = headersOf(HttpHeaders.ContentType, ContentType.Application.Json.toString())
+    }
+}
@@ -0,0 +1,226 @@
+package io.github.kotlin.allfunds.networking.loadtest
+
+import io.ktor.client.engine.HttpClientEngineConfig
+import io.ktor.client.engine.HttpClientEngineFactory
+import io.ktor.client.engine.config
+import io.ktor.client.engine.mock.MockEngine
+import io.ktor.client.engine.mock.MockRequestHandleScope
+import io.ktor.client.engine.mock.respond
+import io.ktor.client.engine.mock.respondError
+import io.ktor.client.request.HttpRequestData
+import io.ktor.client.request.HttpResponseData
+import io.ktor.http.ContentType
+import io.ktor.http.HttpHeaders
+import io.ktor.http.HttpStatusCode
+import io.ktor.http.headersOf
+import io.ktor.utils.io.ByteChannel
+import io.ktor.utils.io.writeFully
+import kotlinx.coroutines.CoroutineScope
+import kotlinx.coroutines.delay
+import kotlinx.coroutines.launch
+import kotlinx.coroutines.sync.Mutex
+import kotlinx.coroutines.sync.withLock
+import kotlinx.io.IOException
+import kotlin.concurrent.atomics.AtomicInt
+import kotlin.concurrent.atomics.ExperimentalAtomicApi
+import kotlin.random.Random
+import kotlin.time.Duration
+
+/**
+ * A fault the engine can inject into responses
+ */
+sealed interface Fault {
+    /**
+     * Extra latency on every request, on top of the stub server latency
+     */
+    data class AddedLatency(val latency: LatencyDistribution) : Fault
+
+    /**
+     * With [probability], stall the response by [spike]
+     */
+    data class LatencySpike(val probability: Double, val spike: Duration) : Fault
+
+    /**
+     * With [probability], send only [keepFraction] of the body while advertising the full length
+     */
+    data class TruncatedBody(val probability: Double, val keepFraction: Double = 0.5) : Fault
+
+    /**
+     * With [probability], deliver the body [chunkBytes] at a time, one chunk every [interval]
+     */
+    data class Trickle(val probability: Double, val chunkBytes: Int, val interval: Duration) : Fault
+
+    /**
+     * With [probability], start a burst of [burstLength] consecutive responses with [status]
+     */
+    data class ErrorBurst(
+        val probability: Double,
+        val status: HttpStatusCode,
+        val burstLength: Int
+    ) : Fault
+
+    /**
+     * With [probability], fail the request as if the connection was reset
+     */
+    data class ConnectionDrop(val probability: Double) : Fault
+}
+
+/**
+ * Injected fault counters
+ */
+data class FaultStats(
+    val spikes: Int,
+    val truncations: Int,
+    val trickles: Int,
+    val burstErrors: Int,
+    val drops: Int,
+    val activeTrickles: Int
+)
+
+/**
+ * Engine that serves the stub server responses with scripted faults
+ *
+ * Every fault decision is drawn from one seeded [Random] in request order, so a sequential
+ * workload sees exactly the same faults on every run with the same seed.
+ *
+ * @param server Stub server producing the healthy responses
+ * @param faults Faults to inject, evaluated in order for every request
+ * @param scope Scope running the trickling body writers
+ * @param seed Seed for all fault decisions
+ */
+@OptIn(ExperimentalAtomicApi::class)
+class FaultInjectingEngine(
+    private val server: ChuckNorrisStubServer,
+    private val faults: List<Fault>,
+    private val scope: CoroutineScope,
+    seed: Long = 1
+) {
+    private val random = Random(seed)
+    private val lock = Mutex()
+    private var burstRemaining = 0
+    private var burstStatus = HttpStatusCode.ServiceUnavailable
+
+    private val spikes = AtomicInt(0)
+    private val truncations = AtomicInt(0)
+    private val trickles = AtomicInt(0)
+    private val burstErrors = AtomicInt(0)
+    private val drops = AtomicInt(0)
+    private val activeTrickles = AtomicInt(0)
+
+    /**
+     * Counters of everything injected so far
+     */
+    val stats: FaultStats
+        get() = FaultStats(
+            spikes = spikes.load(),
+            truncations = truncations.load(),
+            trickles = trickles.load(),
+            burstErrors = burstErrors.load(),
+            drops = drops.load(),
+            activeTrickles = activeTrickles.load()
+        )
+
+    /**
+     * Engine factory serving faulty responses
+     */
+    fun engineFactory(): HttpClientEngineFactory<HttpClientEngineConfig> = MockEngine.config {
+        addHandler { request -> handle(request) }
+    }
+
+    private class Plan {
+        var extraLatency = Duration.ZERO
+        var errorStatus: HttpStatusCode? = null
+        var drop = false
+        var truncate: Fault.TruncatedBody? = null
+        var trickle: Fault.Trickle? = null
+    }
+
+    private suspend fun plan(): Plan = lock.withLock {
+        val plan = Plan()
+        if (burstRemaining > 0) {
+            burstRemaining--
+            plan.errorStatus = burstStatus
+        }
+        for (fault in faults) {
+            when (fault) {
+                is Fault.AddedLatency -> plan.extraLatency += fault.latency.sample(random)
+                is Fault.LatencySpike -> if (random.nextDouble() < fault.probability) {
+                    plan.extraLatency += fault.spike
+                    spikes.incrementAndFetch()
+                }
+                is Fault.TruncatedBody -> if (random.nextDouble() < fault.probability) plan.truncate = fault
+                is Fault.Trickle -> if (random.nextDouble() < fault.probability) plan.trickle = fault
+                is Fault.ErrorBurst -> if (plan.errorStatus == null && random.nextDouble() < fault.probability) {
+                    burstStatus = fault.status
+                    burstRemaining = fault.burstLength - 1
+                    plan.errorStatus = fault.status
+                }
+                is Fault.ConnectionDrop -> if (random.nextDouble() < fault.probability) plan.drop = true
+            }
+        }
+        plan
+    }
+
+    private suspend fun MockRequestHandleScope.handle(request: HttpRequestData): HttpResponseData {
+        val plan = plan()
+        val response = server.resolve(request)
+        val latency = response.latency + plan.extraLatency
+        if (latency > Duration.ZERO) delay(latency)
+
+        if (plan.drop) {
+            drops.incrementAndFetch()
+            throw IOException("Connection reset by peer (injected)")
+        }
+        plan.errorStatus?.let { status ->
+            burstErrors.incrementAndFetch()
+            val headers = if (status == HttpStatusCode.TooManyRequests) {
+                headersOf(HttpHeaders.RetryAfter, "1")
+            } else {
+                headersOf()
+            }
+            return respond(content = "", status = status, headers = headers)
+        }
+        if (response.status != HttpStatusCode.OK) return respondError(response.status)
+
+        val bytes = response.body.encodeToByteArray()
+        val headers = headersOf(
+            HttpHeaders.ContentType to listOf(ContentType.Application.Json.toString()),
+            HttpHeaders.ContentLength to listOf(bytes.size.toString())
+        )
+        plan.truncate?.let { fault ->
+            truncations.incrementAndFetch()
+            val kept = (bytes.size * fault.keepFraction).toInt()
+            return respond(content = bytes.copyOf(kept), status = response.status, headers = headers)
+        }
+        plan.trickle?.let { fault ->
+            trickles.incrementAndFetch()
+            return respond(content = trickle(request, bytes, fault), status = response.status, headers = headers)
+        }
+        return respond(content = bytes, status = response.status, headers = headers)
+    }
+
+    private fun trickle(request: HttpRequestData, bytes: ByteArray, fault: Fault.Trickle): ByteChannel {
+        val channel = ByteChannel()
+        activeTrickles.incrementAndFetch()
+        val writer = scope.launch {
+            try {
+                var offset = 0
+                while (offset < bytes.size) {
+                    val end = minOf(offset + fault.chunkBytes, bytes.size)
+                    channel.writeFully(bytes, offset, end)
+                    channel.flush()
+                    offset = end
+                    if (offset < bytes.size) delay(fault.interval)
+                }
+                channel.flushAndClose()
+            } catch (e: Throwable) {
+                channel.cancel(e)
+            } finally {
+                activeTrickles.decrementAndFetch()
+            }
+        }
+        // Stop writing as soon as the call is done or abandoned by the caller
+        request.executionContext.invokeOnCompletion { writer.cancel() }
+        return channel
+    }
+}
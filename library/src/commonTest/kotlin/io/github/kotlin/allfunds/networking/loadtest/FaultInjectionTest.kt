@@ -0,0 +1,104 @@
+package io.github.kotlin.allfunds.networking.loadtest
+
+import io.github.kotlin.allfunds.networking.data.remote.ChuckNorrisApiConfig
+import io.github.kotlin.allfunds.networking.data.remote.ChuckNorrisApiImpl
+import io.ktor.http.HttpStatusCode
+import kotlinx.coroutines.CoroutineScope
+import kotlinx.coroutines.Dispatchers
+import kotlinx.coroutines.SupervisorJob
+import kotlinx.coroutines.cancel
+import kotlinx.coroutines.delay
+import kotlinx.coroutines.test.runTest
+import kotlinx.coroutines.withContext
+import kotlinx.coroutines.withTimeout
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertFails
+import kotlin.test.assertTrue
+import kotlin.time.Duration.Companion.milliseconds
+import kotlin.time.Duration.Companion.seconds
+
+/**
+ * Behavior of [ChuckNorrisApiImpl] under injected faults
+ */
+class FaultInjectionTest {
+
+    private fun apiFor(engine: FaultInjectingEngine) = ChuckNorrisApiImpl(
+        ChuckNorrisApiConfig(baseUrl = ChuckNorrisStubServer.BASE_URL, engineFactory = engine.engineFactory())
+    )
+
+    private suspend fun outcomes(scope: CoroutineScope, seed: Long): List<Boolean> {
+        val engine = FaultInjectingEngine(
+            server = ChuckNorrisStubServer(),
+            faults = listOf(
+                Fault.ErrorBurst(probability = 0.05, status = HttpStatusCode.TooManyRequests, burstLength = 3),
+                Fault.TruncatedBody(probability = 0.1),
+                Fault.ConnectionDrop(probability = 0.1)
+            ),
+            scope = scope,
+            seed = seed
+        )
+        val api = apiFor(engine)
+        return List(100) {
+            runCatching { api.getRandomJoke() }.isSuccess
+        }
+    }
+
+    @Test
+    fun sameSeedInjectsSameFaults() = runTest {
+        val first = outcomes(backgroundScope, seed = 11)
+        val second = outcomes(backgroundScope, seed = 11)
+
+        assertEquals(first, second)
+        assertTrue(first.count { !it } > 0)
+    }
+
+    @Test
+    fun trickledBodiesAreReclaimedWhenCallerGivesUp() = runTest(timeout = 30.seconds) {
+        // Real-time scope: the trickle has to stay slow while the caller waits on it
+        val writers = CoroutineScope(Dispatchers.Default + SupervisorJob())
+        val engine = FaultInjectingEngine(
+            server = ChuckNorrisStubServer(StubServerConfig(searchResultCount = 50)),
+            faults = listOf(Fault.Trickle(probability = 1.0, chunkBytes = 16, interval = 20.milliseconds)),
+            scope = writers
+        )
+        val api = apiFor(engine)
+
+        withContext(Dispatchers.Default) {
+            assertFails {
+                withTimeout(200.milliseconds) { api.searchJokes("chuck") }
+            }
+            repeat(50) {
+                if (engine.stats.activeTrickles == 0) return@withContext
+                delay(20.milliseconds)
+            }
+        }
+
+        writers.cancel()
+
+        assertEquals(1, engine.stats.trickles)
+        assertEquals(0, engine.stats.activeTrickles)
+    }
+
+    @Test
+    fun injectedFaultsSurfaceAsFailures() = runTest(timeout = 60.seconds) {
+        val engine = FaultInjectingEngine(
+            server = ChuckNorrisStubServer(),
+            faults = listOf(
+                Fault.LatencySpike(probability = 0.05, spike = 50.milliseconds),
+                Fault.ErrorBurst(probability = 0.02, status = HttpStatusCode.ServiceUnavailable, burstLength = 5),
+                Fault.ConnectionDrop(probability = 0.05)
+            ),
+            scope = backgroundScope
+        )
+        val api = apiFor(engine)
+
+        val failures = withContext(Dispatchers.Default) {
+            List(200) { runCatching { api.getRandomJoke() }.isFailure }.count { it }
+        }
+
+        val stats = engine.stats
+        assertEquals(stats.burstErrors + stats.drops, failures)
+        assertTrue(stats.spikes > 0)
+    }
+}
@@ -0,0 +1,86 @@
+package io.github.kotlin.allfunds.networking.loadtest
+
+import io.github.kotlin.allfunds.networking.data.remote.dto.JokeDto
+import io.github.kotlin.allfunds.networking.data.remote.dto.SearchResponseDto
+import kotlinx.serialization.json.Json
+import kotlin.random.Random
+
+/**
+ * Generator of API-shaped joke payloads for load tests and benchmarks
+ */
+object JokeFixtures {
+    /**
+     * Categories served by the real API
+     */
+    val categories = listOf(
+        "animal", "career", "celebrity", "dev", "explicit", "fashion", "food", "history",
+        "money", "movie", "music", "political", "religion", "science", "sport", "travel"
+    )
+
+    private const val ID_ALPHABET = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_"
+    private const val ID_LENGTH = 22
+    private val words = listOf(
+        "Chuck", "Norris", "can", "divide", "by", "zero", "and", "count", "to", "infinity", "twice",
+        "roundhouse", "kicks", "the", "compiler", "until", "it", "apologizes"
+    )
+
+    private val json = Json { encodeDefaults = true }
+
+    /**
+     * Create a random 22 character id with the same alphabet as the real API
+     */
+    fun jokeId(random: Random): String = buildString(ID_LENGTH) {
+        repeat(ID_LENGTH) { append(ID_ALPHABET[random.nextInt(ID_ALPHABET.length)]) }
+    }
+
+    /**
+     * Create a joke text of exactly [length] characters
+     */
+    fun jokeText(random: Random, length: Int): String = buildString(length + 16) {
+        while (this.length < length) {
+            if (isNotEmpty()) append(' ')
+            append(words[random.nextInt(words.size)])
+        }
+        setLength(length)
+    }
+
+    /**
+     * Create a joke DTO as the API would return it
+     * @param valueLength Length of the joke text
+     */
+    fun joke(random: Random, valueLength: Int = 120): JokeDto {
+        val id = jokeId(random)
+        val jokeCategories = if (random.nextInt(4) == 0) listOf(categories[random.nextInt(categories.size)]) else emptyList()
+        return JokeDto(
+            id = id,
+            value = jokeText(random, valueLength),
+            url = "https://api.chucknorris.io/jokes/$id",
+            categories = jokeCategories,
+            createdAt = "2020-01-05 13:42:19.576875",
+            updatedAt = "2020-01-05 13:42:19.576875",
+            iconUrl = "https://api.chucknorris.io/img/avatar/chuck-norris.png"
+        )
+    }
+
+    /**
+     * Create a search response DTO with [count] results
+     */
+    fun searchResponse(random: Random, count: Int, valueLength: Int = 120): SearchResponseDto =
+        SearchResponseDto(total = count, result = List(count) { joke(random, valueLength) })
+
+    /**
+     * Encode a joke as API JSON
+     */
+    fun encode(joke: JokeDto): String = json.encodeToString(JokeDto.serializer(), joke)
+
+    /**
+     * Encode a search response as API JSON
+     */
+    fun encode(response: SearchResponseDto): String = json.encodeToString(SearchResponseDto.serializer(), response)
+
+    /**
+     * Encode the categories list as API JSON
+     */
+    fun encodeCategories(values: List<String> = categories): String =
+        values.joinToString(prefix = "[", postfix = "]") { "\"$it\"" }
+}
@@ -0,0 +1,65 @@
+package io.github.kotlin.allfunds.networking.loadtest
+
+import kotlin.math.ln
+import kotlin.random.Random
+import kotlin.time.Duration
+import kotlin.time.Duration.Companion.microseconds
+import kotlin.time.Duration.Companion.milliseconds
+
+/**
+ * Distribution of the server-side latency added by the stub server
+ */
+sealed interface LatencyDistribution {
+    /**
+     * Draw one latency sample
+     * @param random Source of randomness
+     */
+    fun sample(random: Random): Duration
+
+    /**
+     * Always the same latency
+     */
+    data class Fixed(val latency: Duration) : LatencyDistribution {
+        override fun sample(random: Random): Duration = latency
+    }
+
+    /**
+     * Latency uniformly distributed in [min, max]
+     */
+    data class Uniform(val min: Duration, val max: Duration) : LatencyDistribution {
+        override fun sample(random: Random): Duration {
+            if (max <= min) return min
+            val span = (max - min).inWholeMicroseconds
+            return min + random.nextLong(span + 1).microseconds
+        }
+    }
+
+    /**
+     * Exponentially distributed latency on top of a floor, which models a long tail
+     */
+    data class Exponential(val floor: Duration, val mean: Duration) : LatencyDistribution {
+        override fun sample(random: Random): Duration {
+            val u = 1.0 - random.nextDouble()
+            return floor + mean * -ln(u)
+        }
+    }
+
+    /**
+     * Mostly fast responses with a fraction of slow outliers
+     */
+    data class Bimodal(
+        val fast: Duration,
+        val slow: Duration,
+        val slowFraction: Double
+    ) : LatencyDistribution {
+        override fun sample(random: Random): Duration =
+            if (random.nextDouble() < slowFraction) slow else fast
+    }
+
+    companion object {
+        /**
+         * No added latency
+         */
+        val None: LatencyDistribution = Fixed(0.milliseconds)
+    }
+}
@@ -0,0 +1,156 @@
+package io.github.kotlin.allfunds.networking.loadtest
+
+import io.github.kotlin.allfunds.networking.ChuckNorrisClient
+import io.github.kotlin.allfunds.networking.trace.ClientOperation
+import kotlinx.coroutines.coroutineScope
+import kotlinx.coroutines.delay
+import kotlinx.coroutines.launch
+import kotlin.coroutines.cancellation.CancellationException
+import kotlin.concurrent.atomics.AtomicInt
+import kotlin.concurrent.atomics.ExperimentalAtomicApi
+import kotlin.random.Random
+import kotlin.time.Duration
+import kotlin.time.Duration.Companion.seconds
+import kotlin.time.TimeSource
+
+/**
+ * Weighted mix of operations
+ */
+data class OperationMix(val weights: Map<ClientOperation, Int>) {
+    private val total = weights.values.sum()
+
+    init {
+        require(total > 0) { "Operation mix needs at least one positive weight" }
+    }
+
+    /**
+     * Pick the next operation
+     */
+    fun next(random: Random): ClientOperation {
+        var roll = random.nextInt(total)
+        for ((operation, weight) in weights) {
+            if (roll < weight) return operation
+            roll -= weight
+        }
+        return weights.keys.last()
+    }
+
+    companion object {
+        /**
+         * Roughly the mix seen by the app: mostly random jokes, some searches
+         */
+        val Default = OperationMix(
+            mapOf(
+                ClientOperation.RANDOM to 6,
+                ClientOperation.RANDOM_BY_CATEGORY to 2,
+                ClientOperation.CATEGORIES to 1,
+                ClientOperation.SEARCH to 1
+            )
+        )
+    }
+}
+
+/**
+ * Shape of the offered load
+ */
+sealed interface Workload {
+    /**
+     * [concurrency] workers, each issuing its next call as soon as the previous one finishes
+     */
+    data class ClosedLoop(val concurrency: Int, val totalCalls: Int) : Workload
+
+    /**
+     * Calls arrive at [ratePerSecond] regardless of how fast they complete, for [duration]
+     *
+     * Latency is measured from the scheduled arrival time, so queueing inside the client is
+     * included instead of being hidden by coordinated omission.
+     */
+    data class OpenLoop(val ratePerSecond: Int, val duration: Duration) : Workload
+}
+
+/**
+ * Drives a [ChuckNorrisClient] with a workload and reports throughput, latency and errors
+ *
+ * @param client Client under test
+ * @param mix Operations to issue
+ * @param seed Seed for the operation sequence
+ */
+@OptIn(ExperimentalAtomicApi::class)
+class LoadGenerator(
+    private val client: ChuckNorrisClient,
+    private val mix: OperationMix = OperationMix.Default,
+    seed: Long = 7
+) {
+    private val random = Random(seed)
+
+    /**
+     * Run the workload to completion
+     * @param label Description used in the report
+     */
+    suspend fun run(workload: Workload, label: String = workload.toString()): LoadReport {
+        val recorder = LatencyRecorder()
+        val start = TimeSource.Monotonic.markNow()
+        when (workload) {
+            is Workload.ClosedLoop -> runClosedLoop(workload, recorder)
+            is Workload.OpenLoop -> runOpenLoop(workload, recorder, start)
+        }
+        return recorder.report(label, start.elapsedNow())
+    }
+
+    private suspend fun runClosedLoop(workload: Workload.ClosedLoop, recorder: LatencyRecorder) = coroutineScope {
+        val issued = AtomicInt(0)
+        val operations = List(workload.totalCalls) { mix.next(random) }
+        repeat(workload.concurrency) {
+            launch {
+                while (true) {
+                    val index = issued.fetchAndAdd(1)
+                    if (index >= operations.size) break
+                    val mark = TimeSource.Monotonic.markNow()
+                    val failed = !call(operations[index])
+                    recorder.record(mark.elapsedNow(), failed)
+                }
+            }
+        }
+    }
+
+    private suspend fun runOpenLoop(
+        workload: Workload.OpenLoop,
+        recorder: LatencyRecorder,
+        start: TimeSource.Monotonic.ValueTimeMark
+    ) = coroutineScope {
+        val interval = 1.seconds / workload.ratePerSecond
+        val arrivals = (workload.duration / interval).toInt()
+        for (arrival in 0 until arrivals) {
+            val scheduled = start + interval * arrival
+            val wait = -scheduled.elapsedNow()
+            if (wait > Duration.ZERO) delay(wait)
+            val operation = mix.next(random)
+            launch {
+                val failed = !call(operation)
+                recorder.record(scheduled.elapsedNow(), failed)
+            }
+        }
+    }
+
+    private suspend fun call(operation: ClientOperation): Boolean = client.issue(operation, null)
+}
+
+/**
+ * Issue one client call and report whether it succeeded
+ * @param argument Category, query or batch queries to use, see [io.github.kotlin.allfunds.networking.trace.TraceEvent.argument],
+ * or null for a default one
+ */
+suspend fun ChuckNorrisClient.issue(operation: ClientOperation, argument: String?): Boolean = try {
+    when (operation) {
+        ClientOperation.RANDOM -> getRandomJoke()
+        ClientOperation.RANDOM_BY_CATEGORY -> getRandomJokeByCategory(argument ?: JokeFixtures.categories.first())
+        ClientOperation.CATEGORIES -> getCategories()
+        ClientOperation.SEARCH -> searchJokes(argument ?: "chuck")
+        ClientOperation.SEARCH_BATCH -> searchJokesBatch(argument?.split('\n') ?: listOf("chuck", "kick"))
+    }
+    true
+} catch (e: CancellationException) {
+    throw e
+} catch (e: Exception) {
+    false
+}
@@ -0,0 +1,106 @@
+package io.github.kotlin.allfunds.networking.loadtest
+
+import kotlinx.coroutines.sync.Mutex
+import kotlinx.coroutines.sync.withLock
+import kotlin.time.Duration
+import kotlin.time.Duration.Companion.nanoseconds
+import kotlin.time.DurationUnit
+
+/**
+ * Result of one load run
+ *
+ * @property label Free-form description of the run (engine, pool size, workload)
+ * @property completed Number of calls that finished, successfully or not
+ * @property errors Number of calls that threw
+ * @property elapsed Wall time of the whole run
+ * @property p50 Median latency of the calls
+ * @property p99 99th percentile latency
+ * @property p999 99.9th percentile latency
+ * @property max Slowest call
+ */
+data class LoadReport(
+    val label: String,
+    val completed: Int,
+    val errors: Int,
+    val elapsed: Duration,
+    val p50: Duration,
+    val p99: Duration,
+    val p999: Duration,
+    val max: Duration
+) {
+    /**
+     * Completed calls per second
+     */
+    val throughput: Double
+        get() = if (elapsed > Duration.ZERO) completed / elapsed.toDouble(DurationUnit.SECONDS) else 0.0
+
+    /**
+     * Fraction of calls that threw
+     */
+    val errorRate: Double
+        get() = if (completed > 0) errors.toDouble() / completed else 0.0
+
+    /**
+     * The measured values, as [io.github.kotlin.allfunds.networking.benchmark.BenchmarkLog] records them
+     */
+    fun metrics(): Map<String, Number> = mapOf(
+        "completed" to completed,
+        "errors" to errors,
+        "elapsedMillis" to elapsed.inWholeMilliseconds,
+        "throughput" to throughput,
+        "p50Micros" to p50.inWholeMicroseconds,
+        "p99Micros" to p99.inWholeMicroseconds,
+        "p999Micros" to p999.inWholeMicroseconds,
+        "maxMicros" to max.inWholeMicroseconds
+    )
+
+    override fun toString(): String =
+        "$label: $completed calls in $elapsed (${throughput.toInt()} req/s), " +
+            "p50=$p50 p99=$p99 p999=$p999 max=$max, errors=$errors (${(errorRate * 100).toInt()}%)"
+}
+
+/**
+ * Thread-safe collector of call latencies and outcomes
+ */
+class LatencyRecorder {
+    private val lock = Mutex()
+    private var samples = LongArray(1024)
+    private var size = 0
+    private var errors = 0
+
+    /**
+     * Record one finished call
+     * @param latency Time from the intended start of the call to its completion
+     * @param failed Whether the call threw
+     */
+    suspend fun record(latency: Duration, failed: Boolean) {
+        lock.withLock {
+            if (size == samples.size) samples = samples.copyOf(size * 2)
+            samples[size++] = latency.inWholeNanoseconds
+            if (failed) errors++
+        }
+    }
+
+    /**
+     * Build the report of everything recorded so far
+     */
+    suspend fun report(label: String, elapsed: Duration): LoadReport = lock.withLock {
+        val sorted = samples.copyOf(size).also { it.sort() }
+        LoadReport(
+            label = label,
+            completed = size,
+            errors = errors,
+            elapsed = elapsed,
+            p50 = sorted.percentile(0.50),
+            p99 = sorted.percentile(0.99),
+            p999 = sorted.percentile(0.999),
+            max = if (size > 0) sorted[size - 1].nanoseconds else Duration.ZERO
+        )
+    }
+
+    private fun LongArray.percentile(quantile: Double): Duration {
+        if (isEmpty()) return Duration.ZERO
+        val rank = (quantile * size).toInt().coerceIn(0, size - 1)
+        return this[rank].nanoseconds
+    }
+}
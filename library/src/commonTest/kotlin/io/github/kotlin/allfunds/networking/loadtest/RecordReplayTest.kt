@@ -0,0 +1,86 @@
+package io.github.kotlin.allfunds.networking.loadtest
+
+import io.github.kotlin.allfunds.networking.data.remote.ChuckNorrisApiConfig
+import io.github.kotlin.allfunds.networking.data.remote.ChuckNorrisApiImpl
+import io.github.kotlin.allfunds.networking.data.remote.recording.Cassette
+import io.github.kotlin.allfunds.networking.data.remote.recording.ExchangeRecorder
+import kotlinx.coroutines.test.runTest
+import kotlinx.io.files.Path
+import kotlinx.io.files.SystemFileSystem
+import kotlinx.io.files.SystemTemporaryDirectory
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertFails
+import kotlin.test.assertTrue
+import kotlin.time.Duration.Companion.milliseconds
+
+/**
+ * Recording exchanges against the stub server and replaying them offline
+ */
+class RecordReplayTest {
+
+    private suspend fun record(): Cassette {
+        val server = ChuckNorrisStubServer(
+            StubServerConfig(searchLatency = LatencyDistribution.Fixed(2.milliseconds), searchResultCount = 3)
+        )
+        val recorder = ExchangeRecorder()
+        val api = ChuckNorrisApiImpl(
+            ChuckNorrisApiConfig(baseUrl = server.baseUrl, engineFactory = server.engineFactory(), recorder = recorder)
+        )
+        api.getRandomJoke()
+        api.getCategories()
+        api.searchJokes("kick")
+        return recorder.cassette()
+    }
+
+    @Test
+    fun recordsEveryExchange() = runTest {
+        val cassette = record()
+
+        assertEquals(3, cassette.exchanges.size)
+        val search = cassette.exchanges.last()
+        assertEquals("GET", search.method)
+        assertEquals("${ChuckNorrisStubServer.BASE_URL}/search?query=kick", search.url)
+        assertEquals(200, search.status)
+        assertTrue(search.body.startsWith("{"))
+    }
+
+    @Test
+    fun replayServesRecordedPayloads() = runTest {
+        val cassette = Cassette.decode(record().encode())
+        val replay = ReplayEngine(cassette, timeScale = 0.0)
+        val api = ChuckNorrisApiImpl(
+            ChuckNorrisApiConfig(baseUrl = ChuckNorrisStubServer.BASE_URL, engineFactory = replay.engineFactory())
+        )
+
+        val result = api.searchJokes("kick")
+
+        assertEquals(3, result.total)
+        assertEquals(JokeFixtures.categories, api.getCategories())
+        assertTrue(replay.unmatched().isEmpty())
+    }
+
+    @Test
+    fun replayDetectsUnmatchedRequests() = runTest {
+        val replay = ReplayEngine(record(), timeScale = 0.0)
+        val api = ChuckNorrisApiImpl(
+            ChuckNorrisApiConfig(baseUrl = ChuckNorrisStubServer.BASE_URL, engineFactory = replay.engineFactory())
+        )
+
+        assertFails { api.searchJokes("roundhouse") }
+        assertEquals(listOf("${ChuckNorrisStubServer.BASE_URL}/search?query=roundhouse"), replay.unmatched())
+    }
+
+    @Test
+    fun cassetteRoundTripsThroughDisk() = runTest {
+        val cassette = record()
+        val path = Path(SystemTemporaryDirectory, "chucknorris-cassette-test.jsonl")
+
+        cassette.save(path)
+        try {
+            assertEquals(cassette, Cassette.load(path))
+        } finally {
+            SystemFileSystem.delete(path)
+        }
+    }
+}
@@ -0,0 +1,94 @@
+package io.github.kotlin.allfunds.networking.loadtest
+
+import io.github.kotlin.allfunds.networking.data.remote.recording.Cassette
+import io.github.kotlin.allfunds.networking.data.remote.recording.RecordedExchange
+import io.ktor.client.engine.HttpClientEngineConfig
+import io.ktor.client.engine.HttpClientEngineFactory
+import io.ktor.client.engine.config
+import io.ktor.client.engine.mock.MockEngine
+import io.ktor.client.engine.mock.respond
+import io.ktor.client.request.HttpRequestData
+import io.ktor.http.HttpHeaders
+import io.ktor.http.HttpStatusCode
+import io.ktor.http.Url
+import io.ktor.http.headersOf
+import kotlinx.coroutines.delay
+import kotlinx.coroutines.sync.Mutex
+import kotlinx.coroutines.sync.withLock
+import kotlin.time.Duration.Companion.microseconds
+
+/**
+ * Thrown when a request does not match any exchange of the cassette
+ */
+class UnmatchedRequestException(val url: String) : IllegalStateException("No recorded exchange for $url")
+
+/**
+ * Engine serving the exchanges of a [Cassette] back to the client
+ *
+ * Requests are matched by method, path and query parameters regardless of their order. When
+ * the same request was recorded several times, the recordings are served in order and the
+ * last one is repeated.
+ *
+ * @param cassette Recorded exchanges
+ * @param timeScale Multiplier of the recorded timing: 1.0 replays at the original pace, 0.0 answers immediately
+ */
+class ReplayEngine(
+    cassette: Cassette,
+    private val timeScale: Double = 1.0
+) {
+    private val recordings: Map<String, List<RecordedExchange>> =
+        cassette.exchanges.groupBy { key(it.method, Url(it.url)) }
+    private val lock = Mutex()
+    private val served = mutableMapOf<String, Int>()
+    private val unmatchedUrls = mutableListOf<String>()
+
+    /**
+     * URLs of the requests that matched no recording
+     */
+    suspend fun unmatched(): List<String> = lock.withLock { unmatchedUrls.toList() }
+
+    /**
+     * Engine factory replaying the cassette
+     */
+    fun engineFactory(): HttpClientEngineFactory<HttpClientEngineConfig> = MockEngine.config {
+        addHandler { request ->
+            val exchange = next(request) ?: throw UnmatchedRequestException(request.url.toString())
+            if (timeScale > 0.0) delay(exchange.durationMicros.microseconds * timeScale)
+            val headers = exchange.responseHeaders
+                .filterKeys { name -> droppedHeaders.none { it.equals(name, ignoreCase = true) } }
+                .toList()
+            respond(
+                content = exchange.body,
+                status = HttpStatusCode.fromValue(exchange.status),
+                headers = headersOf(*headers.toTypedArray())
+            )
+        }
+    }
+
+    private suspend fun next(request: HttpRequestData): RecordedExchange? {
+        val key = key(request.method.value, request.url)
+        val candidates = recordings[key]
+        return lock.withLock {
+            if (candidates == null) {
+                unmatchedUrls += request.url.toString()
+                return@withLock null
+            }
+            val index = served[key] ?: 0
+            served[key] = index + 1
+            candidates[minOf(index, candidates.size - 1)]
+        }
+    }
+
+    private fun key(method: String, url: Url): String {
+        val query = url.parameters.entries()
+            .flatMap { (name, values) -> values.map { "$name=$it" } }
+            .sorted()
+            .joinToString("&")
+        return "$method ${url.encodedPath}?$query"
+    }
+
+    private companion object {
+        // The recorded body is already decoded, so framing headers no longer apply
+        val droppedHeaders = listOf(HttpHeaders.ContentLength, HttpHeaders.ContentEncoding, HttpHeaders.TransferEncoding)
+    }
+}
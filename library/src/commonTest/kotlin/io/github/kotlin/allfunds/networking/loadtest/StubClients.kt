@@ -0,0 +1,43 @@
+package io.github.kotlin.allfunds.networking.loadtest
+
+import io.github.kotlin.allfunds.networking.ChuckNorrisClient
+import io.github.kotlin.allfunds.networking.data.remote.ChuckNorrisApi
+import io.github.kotlin.allfunds.networking.data.remote.ChuckNorrisApiConfig
+import io.github.kotlin.allfunds.networking.data.remote.ChuckNorrisApiImpl
+import io.github.kotlin.allfunds.networking.data.repository.JokeRepositoryImpl
+import io.github.kotlin.allfunds.networking.domain.repository.JokeRepository
+import io.github.kotlin.allfunds.networking.domain.usecase.GetCategoriesUseCase
+import io.github.kotlin.allfunds.networking.domain.usecase.GetRandomJokeByCategoryUseCase
+import io.github.kotlin.allfunds.networking.domain.usecase.GetRandomJokeUseCase
+import io.github.kotlin.allfunds.networking.domain.usecase.SearchJokesUseCase
+import org.koin.core.context.startKoin
+import org.koin.dsl.module
+
+/**
+ * Start Koin with the real client stack talking to [server], and create a client on it
+ *
+ * Callers are responsible for stopping Koin afterwards.
+ */
+fun stubClient(server: ChuckNorrisStubServer): ChuckNorrisClient =
+    stubClient(ChuckNorrisApiConfig(baseUrl = server.baseUrl, engineFactory = server.engineFactory()))
+
+/**
+ * Start Koin with the real client stack configured by [config], and create a client on it
+ *
+ * Callers are responsible for stopping Koin afterwards.
+ */
+fun stubClient(config: ChuckNorrisApiConfig): ChuckNorrisClient {
+    startKoin {
+        modules(
+            module {
+                single<ChuckNorrisApi> { ChuckNorrisApiImpl(config) }
+                single<JokeRepository> { JokeRepositoryImpl(get()) }
+                factory { GetRandomJokeUseCase(get()) }
+                factory { GetRandomJokeByCategoryUseCase(get()) }
+                factory { GetCategoriesUseCase(get()) }
+                factory { SearchJokesUseCase(get()) }
+            }
+        )
+    }
+    return ChuckNorrisClient()
+}
@@ -0,0 +1,95 @@
+package io.github.kotlin.allfunds.networking.loadtest
+
+import io.github.kotlin.allfunds.networking.benchmark.BenchmarkLog
+import io.github.kotlin.allfunds.networking.trace.CallTrace
+import io.github.kotlin.allfunds.networking.trace.CallTraceRecorder
+import io.github.kotlin.allfunds.networking.trace.ClientOperation
+import io.github.kotlin.allfunds.networking.trace.TraceEvent
+import kotlinx.coroutines.Dispatchers
+import kotlinx.coroutines.flow.take
+import kotlinx.coroutines.flow.toList
+import kotlinx.coroutines.test.runTest
+import kotlinx.coroutines.withContext
+import org.koin.core.context.stopKoin
+import kotlin.test.AfterTest
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertTrue
+import kotlin.time.Duration.Companion.seconds
+
+/**
+ * Recording client call traces and replaying them against the stub server
+ */
+class TraceReplayTest {
+
+    @AfterTest
+    fun tearDown() {
+        stopKoin()
+    }
+
+    @Test
+    fun recorderCapturesCallsInOrder() = runTest {
+        val client = stubClient(ChuckNorrisStubServer())
+        val recorder = CallTraceRecorder()
+        client.traceRecorder = recorder
+
+        client.getCategories()
+        client.getRandomJokeByCategory("dev")
+        client.searchJokes("kick")
+
+        val trace = CallTrace.decode(recorder.trace().encode())
+        assertEquals(
+            listOf(ClientOperation.CATEGORIES, ClientOperation.RANDOM_BY_CATEGORY, ClientOperation.SEARCH),
+            trace.events.map { it.operation }
+        )
+        assertEquals(listOf(null, "dev", "kick"), trace.events.map { it.argument })
+    }
+
+    @Test
+    fun recorderCapturesBatchesAndStreamedRequests() = runTest {
+        val client = stubClient(ChuckNorrisStubServer())
+        val recorder = CallTraceRecorder()
+        client.traceRecorder = recorder
+
+        client.searchJokesBatch(listOf("kick", "chuck"))
+        client.randomJokeStream(category = "dev", prefetch = 0).take(2).toList()
+
+        val events = CallTrace.decode(recorder.trace().encode()).events
+        assertEquals(ClientOperation.SEARCH_BATCH, events[0].operation)
+        assertEquals(listOf("kick", "chuck"), events[0].argument?.split('\n'))
+        // The stream may have started its next request before the collection was cancelled
+        assertTrue(events.size >= 3, "events: $events")
+        assertTrue(events.drop(1).all { it.operation == ClientOperation.RANDOM_BY_CATEGORY && it.argument == "dev" })
+    }
+
+    @Test
+    fun recorderDropsCallsBeyondCapacity() {
+        val recorder = CallTraceRecorder(capacity = 2)
+
+        repeat(5) { recorder.record(ClientOperation.RANDOM) }
+
+        assertEquals(2, recorder.trace().events.size)
+        assertEquals(3, recorder.dropped)
+    }
+
+    @Test
+    fun replaysLaunchBurstAtAcceleratedSpeed() = runTest(timeout = 30.seconds) {
+        val server = ChuckNorrisStubServer()
+        val client = stubClient(server)
+        // App launch: categories plus a burst of random jokes, then a few searches spread out
+        val launchBurst = List(20) { TraceEvent(offsetMicros = it * 1_000L, operation = ClientOperation.RANDOM) }
+        val searches = List(5) {
+            TraceEvent(offsetMicros = 1_000_000L + it * 500_000L, operation = ClientOperation.SEARCH, argument = "kick")
+        }
+        val trace = CallTrace(listOf(TraceEvent(0, ClientOperation.CATEGORIES)) + launchBurst + searches)
+
+        val report = withContext(Dispatchers.Default) {
+            TraceReplayer(client, server, speedup = 10.0).replay(trace)
+        }
+
+        BenchmarkLog.append("trace-replay-launch", report.metrics())
+        assertEquals(26, report.load.completed)
+        assertEquals(0, report.load.errors)
+        assertEquals(26, report.upstreamRequests)
+    }
+}
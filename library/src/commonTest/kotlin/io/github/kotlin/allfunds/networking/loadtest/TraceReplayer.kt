@@ -0,0 +1,108 @@
+package io.github.kotlin.allfunds.networking.loadtest
+
+import io.github.kotlin.allfunds.networking.ChuckNorrisClient
+import io.github.kotlin.allfunds.networking.data.remote.ConnectionStats
+import io.github.kotlin.allfunds.networking.trace.CallTrace
+import kotlinx.coroutines.coroutineScope
+import kotlinx.coroutines.delay
+import kotlinx.coroutines.launch
+import kotlin.time.Duration
+import kotlin.time.Duration.Companion.microseconds
+import kotlin.time.TimeSource
+
+/**
+ * Result of replaying a trace
+ *
+ * @property load Latency, throughput and errors of the replayed calls
+ * @property upstreamRequests Requests that reached the server; fewer than the calls means
+ * the client answered some of them locally
+ * @property connections Counters of the client's engine after the replay, or null when the engine
+ * reports none, as the stub engine does
+ * @property connectionsEstablished Connections opened during the replay, or null like [connections]
+ */
+data class TraceReplayReport(
+    val load: LoadReport,
+    val upstreamRequests: Int,
+    val connections: ConnectionStats? = null,
+    val connectionsEstablished: Int? = null
+) {
+    /**
+     * Fraction of calls answered without reaching the server
+     */
+    val localHitRate: Double
+        get() = if (load.completed > 0) 1.0 - upstreamRequests.toDouble() / load.completed else 0.0
+
+    /**
+     * The measured values, as [io.github.kotlin.allfunds.networking.benchmark.BenchmarkLog] records them
+     */
+    fun metrics(): Map<String, Number> {
+        val metrics = load.metrics() + mapOf("upstreamRequests" to upstreamRequests, "localHitRate" to localHitRate)
+        val connections = connections ?: return metrics
+        return metrics + mapOf(
+            "connectionsEstablished" to (connectionsEstablished ?: 0),
+            "openConnections" to connections.openConnections,
+            "idleConnections" to connections.idleConnections,
+            "http1Exchanges" to connections.http1Exchanges,
+            "http2Exchanges" to connections.http2Exchanges
+        )
+    }
+
+    override fun toString(): String {
+        val pool = connections?.let { ", connections=$connectionsEstablished new, ${it.openConnections} open" } ?: ""
+        return "$load, upstream=$upstreamRequests (local hits ${(localHitRate * 100).toInt()}%)$pool"
+    }
+}
+
+/**
+ * Feeds a recorded [CallTrace] back into a client wired to a stub server
+ *
+ * Calls are issued open-loop at their recorded offsets divided by [speedup], so bursts in the
+ * trace stay bursts in the replay.
+ *
+ * @param client Client under test
+ * @param upstreamRequests Requests the server the client talks to has received so far
+ * @param speedup 1.0 replays in real time, larger values compress the timeline
+ */
+class TraceReplayer(
+    private val client: ChuckNorrisClient,
+    private val upstreamRequests: () -> Int,
+    private val speedup: Double = 1.0
+) {
+    init {
+        require(speedup > 0.0) { "Speedup must be positive" }
+    }
+
+    /**
+     * Replayer of a client wired to the stub [server]
+     */
+    constructor(client: ChuckNorrisClient, server: ChuckNorrisStubServer, speedup: Double = 1.0) :
+        this(client, { server.totalRequests }, speedup)
+
+    /**
+     * Replay every event of the trace and wait for all calls to finish
+     */
+    suspend fun replay(trace: CallTrace, label: String = "trace x$speedup"): TraceReplayReport {
+        val recorder = LatencyRecorder()
+        val upstreamBefore = upstreamRequests()
+        val connectionsBefore = client.connectionStats()?.connectionsEstablished ?: 0
+        val start = TimeSource.Monotonic.markNow()
+        coroutineScope {
+            for (event in trace.events) {
+                val scheduled = start + event.offsetMicros.microseconds / speedup
+                val wait = -scheduled.elapsedNow()
+                if (wait > Duration.ZERO) delay(wait)
+                launch {
+                    val failed = !client.issue(event.operation, event.argument)
+                    recorder.record(scheduled.elapsedNow(), failed)
+                }
+            }
+        }
+        val connections = client.connectionStats()
+        return TraceReplayReport(
+            load = recorder.report(label, start.elapsedNow()),
+            upstreamRequests = upstreamRequests() - upstreamBefore,
+            connections = connections,
+            connectionsEstablished = connections?.let { it.connectionsEstablished - connectionsBefore }
+        )
+    }
+}
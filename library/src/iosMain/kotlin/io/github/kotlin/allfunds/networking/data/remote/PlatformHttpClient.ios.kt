@@ -0,0 +1,21 @@
+package io.github.kotlin.allfunds.networking.data.remote
+
+import io.ktor.client.HttpClient
+import io.ktor.client.HttpClientConfig
+import io.ktor.client.engine.darwin.Darwin
+
+internal actual fun platformHttpClient(pool: ConnectionPoolConfig, block: HttpClientConfig<*>.() -> Unit): PlatformHttpClient {
+    // NSURLSession negotiates HTTP/2 with ALPN by itself and cannot speak cleartext h2c
+    require(pool.protocol != HttpProtocol.HTTP_2_PRIOR_KNOWLEDGE) { "HTTP/2 with prior knowledge is not supported on iOS" }
+    val client = HttpClient(Darwin) {
+        engine {
+            // NSURLSession manages idle connections itself; only the per-host limit is configurable
+            configureSession {
+                HTTPMaximumConnectionsPerHost = pool.maxConnectionsPerHost.toLong()
+            }
+        }
+        block()
+    }
+    // NSURLSession does not expose its connection pool
+    return PlatformHttpClient(client) { null }
+}
@@ -0,0 +1,6 @@
+package io.github.kotlin.allfunds.networking.data.remote.decode
+
+// NSURLSession negotiates gzip, deflate and br itself and hands over decoded bodies
+internal actual val decodableContentEncodings: List<String> = emptyList()
+
+internal actual fun decompressor(contentEncoding: String): Decompressor? = null
@@ -0,0 +1,15 @@
+package io.github.kotlin.allfunds.networking.benchmark
+
+import kotlin.experimental.ExperimentalNativeApi
+import kotlin.native.Platform
+import kotlin.native.runtime.GC
+import kotlin.native.runtime.NativeRuntimeApi
+
+@OptIn(ExperimentalNativeApi::class)
+actual val platformName: String = "native-${Platform.cpuArchitecture.name.lowercase()}"
+
+@OptIn(NativeRuntimeApi::class)
+actual fun retainedHeapBytes(): Long {
+    GC.collect()
+    return GC.lastGCInfo?.memoryUsageAfter?.values?.sumOf { it.totalObjectsSizeBytes } ?: 0L
+}